@@ -0,0 +1,966 @@
+/**
+ * @file bench.cpp
+ * @brief Benchmarks for the "Air Travel Flight Management System".
+ *
+ * Usage: ./bench <benchmark> [arguments]
+ *   load [scale...]    Startup time of each CSV loader on the bundled data and on synthetic datasets
+ *                      made of 'scale' disjoint copies of it (default scales: 1 10 100).
+ *   ingest [threads...] Startup time of the parallel loader on the x100 dataset with each number of threads
+ *                      (default: powers of two up to the number of hardware threads).
+ *   startup [scale...] Startup time from the CSV files and from the binary snapshot (default scales: 1 10 100).
+ *   qps [threads...]   Throughput of the query engine on a fixed mix of route, reachability and statistics queries
+ *                      (default: powers of two up to the number of hardware threads).
+ *   routes [scale...]  Time of the smallest path search between random airport pairs, with the former BFS copying
+ *                      paths into its queue and with the bidirectional search (default scales: 1 10).
+ *   astar              Settled airports and time of Dijkstra's algorithm and of A* on random airport pairs, for
+ *                      the fewest flights and the shortest distance objectives.
+ *   kpaths [k]         Time and settled airports per route of the K best loopless routes on random airport pairs,
+ *                      for the fewest flights and the shortest distance objectives (default K: 30); fails if a route
+ *                      is not a loopless chain of flights, repeats an earlier one or costs less than it, or if the
+ *                      first route is not the best one.
+ *   pareto [labels...] Time and size of the Pareto front of flights, distance and airline changes on random airport
+ *                      pairs, with each bound on the labels per airport (default: 4 8 16 32 and unbounded), and how many
+ *                      fronts hold the shortest route; fails if an unbounded front misses the fewest flights or the shortest route.
+ *   waypoints [layovers...] Time to order random custom layovers and the distance saved over the entry order, for
+ *                      each number of layovers (default: 2 4 8 12 16 24); fails if an order is not a permutation of
+ *                      the layovers, does not cost what its trip costs, or is longer than the entry order.
+ *   hierarchy          Preprocessing time and size of the contraction hierarchy, and settled airports and time of the
+ *                      shortest distance search on random airport pairs with Dijkstra's algorithm, A* and the hierarchy;
+ *                      fails if they find different distances.
+ *   airlines [pairs]   Time of the airline-constrained search on random airport pairs (default: 200) under several
+ *                      constraints, checked against a brute-force search; fails if they list different paths or airlines.
+ *   diameter [threads...] Time to find the diameter and the airports whose eccentricity is the diameter, from every
+ *                      eccentricity with each number of worker threads (default: powers of two up to the number of
+ *                      hardware threads), checking the diameter, the sources and the endpoints of the longest trips
+ *                      against a breadth-first search from every airport; fails if they differ.
+ *   eccentricity       Time to compute the eccentricity of every airport on one thread, with a queue-based
+ *                      breadth-first search per airport and with the bit-parallel multi-source search; fails if
+ *                      they find different eccentricities.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <random>
+#include "code/QueryEngine.h"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Paths of the three CSV files of a dataset.
+ */
+struct Dataset {
+    std::string airports;   ///< Path of the airports CSV file.
+    std::string airlines;   ///< Path of the airlines CSV file.
+    std::string flights;    ///< Path of the flights CSV file.
+};
+
+/**
+ * @brief Measures the wall time of a function.
+ * @param f The function to measure.
+ * @return The elapsed time in milliseconds.
+ */
+static double timeMs(const std::function<void()>& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Writes 'scale' disjoint copies of a CSV file, renaming the codes of the given columns in every copy but the first.
+ * @param input Path of the original file.
+ * @param output Path of the file to write.
+ * @param scale Number of copies.
+ * @param codeColumns Number of leading columns holding airport codes.
+ */
+static void scaleCsv(const std::string& input, const std::string& output, int scale, int codeColumns) {
+    std::ifstream in(input);
+    std::ofstream out(output);
+    std::string header, line;
+    std::getline(in, header);
+    out << header << '\n';
+
+    std::vector<std::string> rows;
+    while (std::getline(in, line)) rows.push_back(line);
+
+    for (int copy = 0; copy < scale; copy++) {
+        std::string suffix = copy == 0 ? "" : "_" + std::to_string(copy);
+        for (const auto& row : rows) {
+            size_t start = 0;
+            for (int column = 0; column < codeColumns; column++) {
+                size_t comma = row.find(',', start);
+                out << row.substr(start, comma - start) << suffix << ',';
+                start = comma + 1;
+            }
+            out << row.substr(start) << '\n';
+        }
+    }
+}
+
+/**
+ * @brief Creates (once) the synthetic dataset with 'scale' copies of the bundled data.
+ * @param scale Number of copies of the bundled data.
+ * @return The paths of the dataset files.
+ */
+static Dataset syntheticDataset(int scale) {
+    Dataset original{"data/airports.csv", "data/airlines.csv", "data/flights.csv"};
+    if (scale == 1) return original;
+
+    fs::path dir = fs::temp_directory_path() / ("air-traveler-x" + std::to_string(scale));
+    Dataset scaled{(dir / "airports.csv").string(), original.airlines, (dir / "flights.csv").string()};
+    if (!fs::exists(scaled.flights)) {
+        fs::create_directories(dir);
+        scaleCsv(original.airports, scaled.airports, scale, 1);
+        scaleCsv(original.flights, scaled.flights, scale, 2);
+    }
+    return scaled;
+}
+
+/**
+ * @brief Lists the thread counts to measure.
+ * @param requested The thread counts given on the command line.
+ * @return The requested counts, or the powers of two up to the number of hardware threads if none was given.
+ */
+static std::vector<int> threadCounts(const std::vector<int>& requested) {
+    if (!requested.empty()) return requested;
+    std::vector<int> counts;
+    int hardwareThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= hardwareThreads; threads *= 2) counts.push_back(threads);
+    return counts;
+}
+
+/**
+ * @brief Compares the startup time of the CSV loaders.
+ * @param scales The dataset scales to measure.
+ */
+static void benchLoad(const std::vector<int>& scales) {
+    std::cout << std::setw(6) << "scale" << std::setw(12) << "airports" << std::setw(12) << "routes"
+              << std::setw(14) << "stream (ms)" << std::setw(14) << "mapped (ms)"
+              << std::setw(16) << "parallel (ms)" << std::setw(10) << "speedup" << std::endl;
+
+    for (int scale : scales) {
+        Dataset dataset = syntheticDataset(scale);
+        int airports = 0, routes = 0;
+        double stream = timeMs([&]() {
+            ParseData parseData(dataset.airports, dataset.airlines, dataset.flights, ParseData::LoadMode::STREAM);
+            airports = parseData.getDataGraph().getNumVertex();
+            for (auto v : parseData.getDataGraph().getVertexSet()) routes += v->getOutDegree();
+        });
+        double mapped = timeMs([&]() {
+            ParseData parseData(dataset.airports, dataset.airlines, dataset.flights, ParseData::LoadMode::MAPPED);
+        });
+        double parallel = timeMs([&]() {
+            ParseData parseData(dataset.airports, dataset.airlines, dataset.flights, ParseData::LoadMode::PARALLEL);
+        });
+        std::cout << std::setw(6) << scale << std::setw(12) << airports << std::setw(12) << routes << std::fixed << std::setprecision(1)
+                  << std::setw(14) << stream << std::setw(14) << mapped << std::setw(16) << parallel
+                  << std::setw(9) << stream / parallel << "x" << std::endl;
+    }
+}
+
+/**
+ * @brief Measures how the parallel loader scales with the number of threads.
+ * @param threadCounts The numbers of threads to measure.
+ */
+static void benchIngest(const std::vector<int>& threadCounts) {
+    Dataset dataset = syntheticDataset(100);
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "time (ms)" << std::setw(10) << "speedup" << std::endl;
+
+    double base = 0;
+    for (int threads : threadCounts) {
+        double time = timeMs([&]() {
+            ParseData parseData(dataset.airports, dataset.airlines, dataset.flights, ParseData::LoadMode::PARALLEL, threads);
+        });
+        if (base == 0) base = time;
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(1) << std::setw(12) << time
+                  << std::setw(9) << base / time << "x" << std::endl;
+    }
+}
+
+/**
+ * @brief Compares the startup time from the CSV files with the one from a binary snapshot.
+ * @param scales The dataset scales to measure.
+ */
+static void benchStartup(const std::vector<int>& scales) {
+    std::cout << std::setw(6) << "scale" << std::setw(12) << "csv (ms)" << std::setw(16) << "snapshot (ms)"
+              << std::setw(16) << "snapshot (MB)" << std::setw(10) << "speedup" << std::endl;
+
+    for (int scale : scales) {
+        Dataset dataset = syntheticDataset(scale);
+        std::string snapshotFile = (fs::temp_directory_path() / ("air-traveler-x" + std::to_string(scale) + ".snapshot")).string();
+        fs::remove(snapshotFile);
+
+        double csv = timeMs([&]() {
+            ParseData parseData(dataset.airports, dataset.airlines, dataset.flights);
+        });
+        { ParseData writer(dataset.airports, dataset.airlines, dataset.flights, snapshotFile); }
+        bool loaded = false;
+        double snapshot = timeMs([&]() {
+            ParseData parseData(dataset.airports, dataset.airlines, dataset.flights, snapshotFile);
+            loaded = parseData.isFromSnapshot();
+        });
+        if (!loaded) {
+            std::cerr << "The snapshot of scale " << scale << " was not used" << std::endl;
+            continue;
+        }
+        std::cout << std::setw(6) << scale << std::fixed << std::setprecision(1) << std::setw(12) << csv << std::setw(16) << snapshot
+                  << std::setw(16) << fs::file_size(snapshotFile) / 1e6 << std::setw(9) << csv / snapshot << "x" << std::endl;
+    }
+}
+
+/**
+ * @brief Measures the throughput of the query engine with each number of worker threads.
+ * @param threadCounts The numbers of threads to measure.
+ */
+static void benchQps(const std::vector<int>& threadCounts) {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    auto airports = parseData.getDataGraph().getVertexSet();
+
+    // Same queries for every thread count: 2000 routes, 2000 reachability and 2000 statistics queries
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> routes;
+    std::vector<std::pair<Vertex<Airport>*, int>> reachability;
+    std::vector<Vertex<Airport>*> statistics;
+    for (int i = 0; i < 2000; i++) {
+        routes.emplace_back(airports[pick(random)], airports[pick(random)]);
+        reachability.emplace_back(airports[pick(random)], i % 4);
+        statistics.push_back(airports[pick(random)]);
+    }
+    int queries = static_cast<int>(routes.size() + reachability.size() + statistics.size());
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", queries: " << queries << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "time (ms)" << std::setw(12) << "qps" << std::setw(14) << "checksum" << std::endl;
+    for (int threads : threadCounts) {
+        QueryEngine engine(parseData.getDataGraph(), parseData.getAirlineRegistry(), threads);
+        long checksum = 0;
+        double time = timeMs([&]() {
+            auto routeResults = engine.submitRoutes(routes);
+            auto reachabilityResults = engine.submitReachability(reachability);
+            auto statisticsResults = engine.submitStatistics(statistics);
+            for (auto& result : routeResults) checksum += static_cast<long>(result.get().size());
+            for (auto& result : reachabilityResults) checksum += result.get();
+            for (auto& result : statisticsResults) checksum += result.get().reachableAirports;
+        });
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(1) << std::setw(12) << time
+                  << std::setw(12) << queries / (time / 1000) << std::setw(14) << checksum << std::endl;
+    }
+}
+
+/**
+ * @brief The smallest path search as it was before the bidirectional search, kept as the baseline of the routes benchmark.
+ * @param graph The airport graph.
+ * @param source The starting airport.
+ * @param target The destination airport.
+ * @return The smallest paths it finds (a single path through each intermediate airport).
+ */
+static std::vector<std::vector<Vertex<Airport>*>> legacySmallestPaths(const Graph<Airport>& graph, Vertex<Airport>* source, Vertex<Airport>* target) {
+    std::vector<std::vector<Vertex<Airport>*>> smallestPaths;
+    std::vector<bool> visited(graph.getNumVertex(), false);
+    std::queue<std::pair<std::vector<Vertex<Airport>*>, Vertex<Airport>*>> q;
+    q.push({{source}, source});
+    visited[source->getId()] = true;
+    size_t smallestSize = std::numeric_limits<size_t>::max();
+
+    while (!q.empty()) {
+        auto current = q.front();
+        q.pop();
+        for (auto& flight : current.second->getAdj()) {
+            auto neighbor = flight.getDest();
+            if (neighbor == target) {
+                current.first.emplace_back(neighbor);
+                if (current.first.size() < smallestSize) {
+                    smallestPaths.clear();
+                    smallestSize = current.first.size();
+                }
+                if (current.first.size() == smallestSize)
+                    smallestPaths.push_back(current.first);
+            } else if (!visited[neighbor->getId()]) {
+                visited[neighbor->getId()] = true;
+                std::vector<Vertex<Airport>*> newPath = current.first;
+                newPath.emplace_back(neighbor);
+                q.emplace(newPath, neighbor);
+            }
+        }
+    }
+    return smallestPaths;
+}
+
+/**
+ * @brief Compares the smallest path search of the former BFS with the bidirectional search on random airport pairs.
+ * @param scales The dataset scales to measure.
+ */
+static void benchRoutes(const std::vector<int>& scales) {
+    std::cout << std::setw(6) << "scale" << std::setw(8) << "pairs" << std::setw(16) << "legacy (us)" << std::setw(20) << "bidirectional (us)"
+              << std::setw(10) << "speedup" << std::setw(14) << "legacy paths" << std::setw(12) << "all paths" << std::endl;
+
+    for (int scale : scales) {
+        Dataset dataset = syntheticDataset(scale);
+        ParseData parseData(dataset.airports, dataset.airlines, dataset.flights);
+        Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+        auto airports = parseData.getDataGraph().getVertexSet();
+
+        // Pairs inside the same copy of the data, as the copies are disconnected from each other
+        int perCopy = static_cast<int>(airports.size()) / scale;
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> pickCopy(0, scale - 1), pickAirport(0, perCopy - 1);
+        std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> pairs;
+        for (int i = 0; i < 1000; i++) {
+            int copy = pickCopy(random);
+            pairs.emplace_back(airports[copy * perCopy + pickAirport(random)], airports[copy * perCopy + pickAirport(random)]);
+        }
+
+        long legacyPaths = 0, allPaths = 0;
+        double legacy = timeMs([&]() {
+            for (const auto& pair : pairs) legacyPaths += static_cast<long>(legacySmallestPaths(parseData.getDataGraph(), pair.first, pair.second).size());
+        });
+        double bidirectional = timeMs([&]() {
+            for (const auto& pair : pairs) allPaths += static_cast<long>(consult.searchSmallestPathBetweenAirports(pair.first, pair.second).size());
+        });
+        std::cout << std::setw(6) << scale << std::setw(8) << pairs.size() << std::fixed << std::setprecision(1)
+                  << std::setw(16) << legacy * 1000 / pairs.size() << std::setw(20) << bidirectional * 1000 / pairs.size()
+                  << std::setw(9) << legacy / bidirectional << "x" << std::setw(14) << legacyPaths << std::setw(12) << allPaths << std::endl;
+    }
+}
+
+/**
+ * @brief Compares Dijkstra's algorithm with the A* search on random airport pairs.
+ */
+static void benchAStar() {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+    auto airports = parseData.getDataGraph().getVertexSet();
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> pairs;
+    for (int i = 0; i < 2000; i++) pairs.emplace_back(airports[pick(random)], airports[pick(random)]);
+
+    std::cout << "pairs: " << pairs.size() << std::endl;
+    std::cout << std::setw(10) << "objective" << std::setw(12) << "search" << std::setw(16) << "settled/query"
+              << std::setw(14) << "time (us)" << std::setw(16) << "total cost" << std::endl;
+    for (RouteObjective objective : {RouteObjective::FLIGHTS, RouteObjective::DISTANCE}) {
+        for (bool useHeuristic : {false, true}) {
+            long settled = 0;
+            double cost = 0;
+            double time = timeMs([&]() {
+                for (const auto& pair : pairs) {
+                    Route route = consult.searchBestRoute({pair.first}, {pair.second}, objective, useHeuristic);
+                    settled += route.settled;
+                    cost += objective == RouteObjective::DISTANCE ? route.distance : static_cast<double>(route.airports.size());
+                }
+            });
+            std::cout << std::setw(10) << (objective == RouteObjective::DISTANCE ? "distance" : "flights")
+                      << std::setw(12) << (useHeuristic ? "A*" : "Dijkstra") << std::fixed << std::setprecision(1)
+                      << std::setw(16) << static_cast<double>(settled) / pairs.size() << std::setw(14) << time * 1000 / pairs.size()
+                      << std::setw(16) << cost << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Measures the enumeration of the K best loopless routes on random airport pairs, and checks that the routes
+ * are distinct loopless chains of flights in order of cost, starting with the best route of the A* search.
+ * @param k The number of routes per pair.
+ * @return True if every enumeration passes the checks, otherwise false.
+ */
+static bool benchKPaths(int k) {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+    auto airports = parseData.getDataGraph().getVertexSet();
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> pairs;
+    for (int i = 0; i < 300; i++) pairs.emplace_back(airports[pick(random)], airports[pick(random)]);
+
+    std::cout << "pairs: " << pairs.size() << ", routes per pair: " << k << std::endl;
+    std::cout << std::setw(10) << "objective" << std::setw(14) << "routes/pair" << std::setw(16) << "first (us)"
+              << std::setw(16) << "next (us)" << std::setw(18) << "settled/next" << std::endl;
+    const Graph<Airport>& graph = parseData.getDataGraph();
+    bool valid = true;
+    for (RouteObjective objective : {RouteObjective::FLIGHTS, RouteObjective::DISTANCE}) {
+        auto cost = [objective](const Route& route) {
+            return objective == RouteObjective::DISTANCE ? route.distance : static_cast<double>(route.airports.size() - 1);
+        };
+        long routes = 0, following = 0, settled = 0;
+        double first = 0, next = 0;
+        for (const auto& pair : pairs) {
+            KShortestPaths enumeration = consult.enumerateBestRoutes(pair.first, pair.second, objective);
+            std::set<std::vector<Vertex<Airport>*>> seen;
+            double previous = 0;
+            Route route;
+            bool more = true;
+            first += timeMs([&]() { more = enumeration.next(route, SearchContext::local()); });
+            Route best = consult.searchBestRoute({pair.first}, {pair.second}, objective);
+            valid &= more == !best.airports.empty() && (!more || std::abs(cost(route) - cost(best)) <= 1e-6 * cost(best));
+            while (more) {
+                std::set<Vertex<Airport>*> airports(route.airports.begin(), route.airports.end());
+                valid &= airports.size() == route.airports.size() && seen.insert(route.airports).second;
+                valid &= route.airports.front() == pair.first && route.airports.back() == pair.second;
+                for (size_t i = 0; i + 1 < route.airports.size(); i++) valid &= graph.findEdge(route.airports[i], route.airports[i + 1]) != nullptr;
+                valid &= cost(route) >= previous - 1e-6 * previous;
+                previous = cost(route);
+                if (enumeration.getCount() >= k) break;
+                next += timeMs([&]() { more = enumeration.next(route, SearchContext::local()); });
+                settled += route.settled;
+                following++;
+            }
+            routes += enumeration.getCount();
+        }
+        std::cout << std::setw(10) << (objective == RouteObjective::DISTANCE ? "distance" : "flights")
+                  << std::fixed << std::setprecision(1) << std::setw(14) << static_cast<double>(routes) / pairs.size()
+                  << std::setw(16) << first * 1000 / pairs.size() << std::setw(16) << next * 1000 / std::max(1L, following)
+                  << std::setw(18) << static_cast<double>(settled) / std::max(1L, following) << std::endl;
+    }
+    std::cout << "valid routes: " << (valid ? "yes" : "no") << std::endl;
+    return valid;
+}
+
+/**
+ * @brief Measures the Pareto front search on random airport pairs with each bound on the labels per airport, and
+ * checks the fronts against the routes with the fewest flights and with the shortest distance.
+ * @param bounds The bounds on the labels per airport, std::numeric_limits<int>::max() for none.
+ * @return True if every front has the fewest flights and every unbounded front has the shortest route, otherwise false.
+ */
+static bool benchPareto(const std::vector<int>& bounds) {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+    auto airports = parseData.getDataGraph().getVertexSet();
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> pairs;
+    for (int i = 0; i < 300; i++) pairs.emplace_back(airports[pick(random)], airports[pick(random)]);
+
+    std::vector<Route> fewest, shortest;
+    for (const auto& pair : pairs) {
+        fewest.push_back(consult.searchBestRoute({pair.first}, {pair.second}, RouteObjective::FLIGHTS));
+        shortest.push_back(consult.searchBestRoute({pair.first}, {pair.second}, RouteObjective::DISTANCE));
+    }
+
+    std::cout << "pairs: " << pairs.size() << std::endl;
+    std::cout << std::setw(12) << "labels" << std::setw(14) << "front/query" << std::setw(14) << "time (us)"
+              << std::setw(16) << "total distance" << std::setw(16) << "total changes" << std::setw(12) << "shortest" << std::endl;
+    bool valid = true;
+    for (int bound : bounds) {
+        long itineraries = 0, changes = 0;
+        double distance = 0;
+        std::vector<std::vector<ParetoItinerary>> fronts;
+        double time = timeMs([&]() {
+            for (const auto& pair : pairs) {
+                fronts.push_back(consult.searchParetoItineraries({pair.first}, {pair.second}, {}, bound));
+                itineraries += static_cast<long>(fronts.back().size());
+                for (const auto& itinerary : fronts.back()) {
+                    distance += itinerary.distance;
+                    changes += itinerary.changes;
+                }
+            }
+        });
+
+        // The front is sorted by flights, and the shortest route is on it unless the labels were bounded
+        int withShortest = 0;
+        for (size_t i = 0; i < pairs.size(); i++) {
+            const auto& front = fronts[i];
+            if (front.empty() || fewest[i].airports.empty()) {
+                valid &= front.empty() && fewest[i].airports.empty();
+                withShortest++;
+                continue;
+            }
+            valid &= front[0].airports.size() == fewest[i].airports.size();
+            double best = std::min_element(front.begin(), front.end(), [](const ParetoItinerary& a, const ParetoItinerary& b) {
+                return a.distance < b.distance;
+            })->distance;
+            bool hasShortest = std::abs(best - shortest[i].distance) <= 1e-6 * shortest[i].distance;
+            withShortest += hasShortest;
+            valid &= hasShortest || bound != std::numeric_limits<int>::max();
+        }
+
+        std::cout << std::setw(12) << (bound == std::numeric_limits<int>::max() ? std::string("unbounded") : std::to_string(bound))
+                  << std::fixed << std::setprecision(2) << std::setw(14) << static_cast<double>(itineraries) / pairs.size()
+                  << std::setprecision(1) << std::setw(14) << time * 1000 / pairs.size() << std::setw(16) << distance
+                  << std::setw(16) << changes << std::setw(12) << withShortest << std::endl;
+    }
+    std::cout << "valid fronts: " << (valid ? "yes" : "no") << std::endl;
+    return valid;
+}
+
+/**
+ * @brief Measures the ordering of random custom layovers for the shortest distance with each number of layovers, and
+ * checks every order against the trip through the layovers in that order and in the entry order.
+ * @param sizes The numbers of layovers.
+ * @return True if every order visits each layover once, costs what its trip costs and is no longer than the entry
+ * order, otherwise false.
+ */
+static bool benchWaypoints(const std::vector<int>& sizes) {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+    auto airports = parseData.getDataGraph().getVertexSet();
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    const int trips = 50;
+
+    std::cout << "trips per size: " << trips << std::endl;
+    std::cout << std::setw(10) << "layovers" << std::setw(10) << "exact" << std::setw(14) << "plan (ms)"
+              << std::setw(20) << "entry order (km)" << std::setw(20) << "best order (km)" << std::endl;
+    bool valid = true;
+    for (int size : sizes) {
+        double time = 0, entered = 0, planned = 0;
+        for (int i = 0; i < trips; i++) {
+            Vertex<Airport>* source = airports[pick(random)];
+            Vertex<Airport>* target = airports[pick(random)];
+            std::vector<Vertex<Airport>*> layovers;
+            while (static_cast<int>(layovers.size()) < size) {
+                Vertex<Airport>* layover = airports[pick(random)];
+                if (std::find(layovers.begin(), layovers.end(), layover) == layovers.end()) layovers.push_back(layover);
+            }
+
+            WaypointPlan plan;
+            time += timeMs([&]() { plan = consult.planLayovers({source}, {target}, layovers, RouteObjective::DISTANCE); });
+            auto trip = consult.getShortestDistancePaths({source}, {target}, layovers);
+            valid &= plan.reachable || trip.empty();
+            if (!plan.reachable || trip.empty()) continue;
+            entered += trip[0].second.second;
+            planned += plan.distance;
+
+            std::vector<int> positions = plan.order;
+            std::sort(positions.begin(), positions.end());
+            std::vector<int> identity(size);
+            std::iota(identity.begin(), identity.end(), 0);
+            std::vector<Vertex<Airport>*> ordered;
+            for (int position : plan.order) ordered.push_back(layovers[position]);
+            auto plannedTrip = consult.getShortestDistancePaths({source}, {target}, ordered);
+            valid &= positions == identity && !plannedTrip.empty();
+            valid &= plannedTrip.empty() || std::abs(plannedTrip[0].second.second - plan.distance) <= 1e-6 * plan.distance;
+            valid &= plan.distance <= trip[0].second.second * (1 + 1e-9);
+        }
+        std::cout << std::setw(10) << size << std::setw(10) << (size <= WaypointPlanner::HELD_KARP_MAX_WAYPOINTS ? "yes" : "no")
+                  << std::fixed << std::setprecision(2) << std::setw(14) << time / trips << std::setprecision(0)
+                  << std::setw(20) << entered << std::setw(20) << planned << std::endl;
+    }
+    std::cout << "valid orders: " << (valid ? "yes" : "no") << std::endl;
+    return valid;
+}
+
+/**
+ * @brief Measures the preprocessing of the contraction hierarchy, and compares the shortest distance searches with
+ * Dijkstra's algorithm, A* and the hierarchy on random airport pairs.
+ * @return True if the three searches find the same distance for every pair, otherwise false.
+ */
+static bool benchHierarchy() {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    FrozenGraph frozenGraph(parseData.getDataGraph());
+    ContractionHierarchy hierarchy;
+    double preprocessing = timeMs([&]() { hierarchy = ContractionHierarchy(frozenGraph, SearchContext::local()); });
+    std::cout << "preprocessing: " << std::fixed << std::setprecision(1) << preprocessing << " ms, flight routes: "
+              << frozenGraph.getNumEdges() << ", arcs: " << hierarchy.getArcs().size() << std::endl;
+
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry(), [&hierarchy]() { return &hierarchy; });
+    auto airports = parseData.getDataGraph().getVertexSet();
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> pairs;
+    while (pairs.size() < 2000) {
+        Vertex<Airport>* source = airports[pick(random)];
+        Vertex<Airport>* target = airports[pick(random)];
+        if (source != target) pairs.emplace_back(source, target);
+    }
+
+    std::cout << "pairs: " << pairs.size() << std::endl;
+    std::cout << std::setw(12) << "search" << std::setw(16) << "settled/query" << std::setw(14) << "time (us)"
+              << std::setw(18) << "total distance" << std::endl;
+    std::vector<Route> reference;
+    bool sameDistances = true;
+    for (const std::string search : {"Dijkstra", "A*", "hierarchy"}) {
+        long settled = 0;
+        double distance = 0;
+        std::vector<Route> routes;
+        double time = timeMs([&]() {
+            for (const auto& pair : pairs) {
+                routes.push_back(search == "hierarchy" ? consult.searchShortestRoute({pair.first}, {pair.second})
+                                                       : consult.searchBestRoute({pair.first}, {pair.second}, RouteObjective::DISTANCE, search == "A*"));
+                settled += routes.back().settled;
+                distance += routes.back().distance;
+            }
+        });
+        std::cout << std::setw(12) << search << std::fixed << std::setprecision(1)
+                  << std::setw(16) << static_cast<double>(settled) / pairs.size() << std::setw(14) << time * 1000 / pairs.size()
+                  << std::setw(18) << distance << std::endl;
+
+        // Ties may be broken differently, so only the reachability and the distances must agree with Dijkstra's algorithm
+        if (reference.empty()) reference = routes;
+        for (size_t i = 0; i < pairs.size(); i++) {
+            sameDistances &= routes[i].airports.empty() == reference[i].airports.empty();
+            sameDistances &= std::abs(routes[i].distance - reference[i].distance) <= 1e-6 * reference[i].distance;
+        }
+    }
+    std::cout << "same distances: " << (sameDistances ? "yes" : "no") << std::endl;
+    return sameDistances;
+}
+
+/**
+ * @brief Lists by brute force the airport paths with the fewest flights that an itinerary satisfying airline
+ * constraints flies, trying every walk of each length with the airline changes counted flight by flight.
+ * @param graph The airport graph.
+ * @param toTarget The fewest flights from each airport to the target, ignoring airlines (-1 if unreachable).
+ * @param source The starting airport.
+ * @param target The destination airport.
+ * @param layovers The airports the walks must go through, in order.
+ * @param constraints The airline constraints.
+ * @param maxFlights The longest walks tried.
+ * @return Each airport path with the airlines each of its flights can be flown with, empty if none has at most 'maxFlights' flights.
+ */
+static std::map<std::vector<Vertex<Airport>*>, std::vector<std::vector<AirlineId>>> bruteForceAirlinePaths(
+        const std::vector<int>& toTarget, Vertex<Airport>* source, Vertex<Airport>* target,
+        const std::vector<Vertex<Airport>*>& layovers, const AirlineConstraints& constraints, int maxFlights) {
+    std::map<std::vector<Vertex<Airport>*>, std::vector<std::vector<AirlineId>>> paths;
+    std::vector<Vertex<Airport>*> walk = {source};
+    std::vector<const Edge<Airport>*> flights;
+
+    // Airlines valid on each flight: some sequence through them has at most maxChanges changes
+    auto addWalk = [&]() {
+        size_t n = flights.size();
+        std::vector<std::vector<AirlineId>> usable(n);
+        for (size_t i = 0; i < n; i++) {
+            for (AirlineId airline : flights[i]->getAirlines()) {
+                if ((constraints.allowed.empty() || constraints.allowed.contains(airline)) && !(!constraints.denied.empty() && constraints.denied.contains(airline)))
+                    usable[i].push_back(airline);
+            }
+            if (usable[i].empty()) return;
+        }
+        const int infinity = std::numeric_limits<int>::max() / 2;
+        std::vector<std::vector<int>> before(n), after(n);
+        for (size_t i = 0; i < n; i++) {
+            for (AirlineId airline : usable[i]) {
+                int best = i == 0 ? 0 : infinity;
+                for (size_t j = 0; i > 0 && j < usable[i - 1].size(); j++)
+                    best = std::min(best, before[i - 1][j] + (usable[i - 1][j] != airline));
+                before[i].push_back(best);
+            }
+        }
+        for (size_t i = n; i-- > 0;) {
+            for (AirlineId airline : usable[i]) {
+                int best = i == n - 1 ? 0 : infinity;
+                for (size_t j = 0; i < n - 1 && j < usable[i + 1].size(); j++)
+                    best = std::min(best, after[i + 1][j] + (usable[i + 1][j] != airline));
+                after[i].push_back(best);
+            }
+        }
+        std::vector<std::vector<AirlineId>> valid(n);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < usable[i].size(); j++) {
+                if (constraints.maxChanges < 0 || before[i][j] + after[i][j] <= constraints.maxChanges)
+                    valid[i].push_back(usable[i][j]);
+            }
+            if (valid[i].empty()) return;
+        }
+        auto& known = paths[walk];
+        if (known.empty()) known.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            known[i].insert(known[i].end(), valid[i].begin(), valid[i].end());
+            std::sort(known[i].begin(), known[i].end());
+            known[i].erase(std::unique(known[i].begin(), known[i].end()), known[i].end());
+        }
+    };
+
+    std::function<void(size_t, int)> extend = [&](size_t leg, int length) {
+        Vertex<Airport>* airport = walk.back();
+        if (static_cast<int>(flights.size()) == length) {
+            if (airport == target && leg == layovers.size()) addWalk();
+            return;
+        }
+        // The search stops at the target once every layover is visited
+        if (airport == target && leg == layovers.size() && !flights.empty()) return;
+        for (const auto& flight : airport->getAdj()) {
+            Vertex<Airport>* next = flight.getDest();
+            int left = toTarget[next->getId()];
+            if (left == -1 || static_cast<int>(flights.size()) + 1 + left > length) continue;
+            walk.push_back(next);
+            flights.push_back(&flight);
+            extend(leg < layovers.size() && next == layovers[leg] ? leg + 1 : leg, length);
+            flights.pop_back();
+            walk.pop_back();
+        }
+    };
+    for (int length = 1; length <= maxFlights && paths.empty(); length++)
+        extend(0, length);
+    return paths;
+}
+
+/**
+ * @brief Checks the airline-constrained search against a brute-force search on random airport pairs.
+ * @param numPairs The number of airport pairs.
+ * @return True if both searches agree on every pair, otherwise false.
+ */
+static bool benchAirlines(int numPairs) {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+    const Graph<Airport>& graph = parseData.getDataGraph();
+    auto airports = graph.getVertexSet();
+    int numAirlines = parseData.getAirlineRegistry().size();
+    const int maxFlights = 4;
+
+    std::vector<std::vector<int>> incoming(airports.size());
+    std::vector<int> routes(numAirlines);
+    for (auto airport : airports) {
+        for (const auto& flight : airport->getAdj()) {
+            incoming[flight.getDest()->getId()].push_back(airport->getId());
+            for (AirlineId airline : flight.getAirlines()) routes[airline]++;
+        }
+    }
+    std::vector<AirlineId> busiest(numAirlines);
+    for (int airline = 0; airline < numAirlines; airline++) busiest[airline] = static_cast<AirlineId>(airline);
+    std::sort(busiest.begin(), busiest.end(), [&](AirlineId a, AirlineId b) { return routes[a] > routes[b]; });
+
+    std::vector<std::pair<std::string, AirlineConstraints>> settings;
+    for (int maxChanges : {0, 1, -1}) {
+        AirlineConstraints constraints;
+        constraints.maxChanges = maxChanges;
+        settings.emplace_back(maxChanges < 0 ? "any changes" : std::to_string(maxChanges) + " change(s)", constraints);
+    }
+    AirlineConstraints allowed;
+    allowed.allowed = AirlineSet(numAirlines);
+    for (int i = 0; i < 40; i++) allowed.allowed.insert(busiest[i]);
+    allowed.maxChanges = 1;
+    settings.emplace_back("40 allowed, 1 change", allowed);
+    AirlineConstraints denied;
+    denied.denied = AirlineSet(numAirlines);
+    for (int i = 0; i < 10; i++) denied.denied.insert(busiest[i]);
+    settings.emplace_back("10 denied, 0 change", denied);
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, airports.size() - 1);
+    std::vector<std::tuple<Vertex<Airport>*, Vertex<Airport>*, std::vector<Vertex<Airport>*>>> trips;
+    while (static_cast<int>(trips.size()) < numPairs) {
+        Vertex<Airport>* source = airports[pick(random)];
+        Vertex<Airport>* target = airports[pick(random)];
+        std::vector<Vertex<Airport>*> layovers;
+        if (trips.size() % 4 == 3) layovers.push_back(airports[pick(random)]);
+        if (source != target) trips.emplace_back(source, target, layovers);
+    }
+
+    // Fewest flights to each target, the pruning bound of the brute-force search
+    std::map<Vertex<Airport>*, std::vector<int>> toTarget;
+    for (const auto& trip : trips) {
+        std::vector<int>& distance = toTarget[std::get<1>(trip)];
+        if (!distance.empty()) continue;
+        distance.assign(airports.size(), -1);
+        std::vector<int> queue = {std::get<1>(trip)->getId()};
+        distance[queue[0]] = 0;
+        for (size_t head = 0; head < queue.size(); head++) {
+            for (int previous : incoming[queue[head]]) {
+                if (distance[previous] != -1) continue;
+                distance[previous] = distance[queue[head]] + 1;
+                queue.push_back(previous);
+            }
+        }
+    }
+
+    std::cout << "pairs: " << trips.size() << ", brute force up to " << maxFlights << " flights" << std::endl;
+    std::cout << std::setw(22) << "constraints" << std::setw(10) << "routed" << std::setw(10) << "paths" << std::setw(14)
+              << "search (us)" << std::setw(18) << "brute force (us)" << std::setw(12) << "mismatches" << std::endl;
+    bool ok = true;
+    for (const auto& setting : settings) {
+        long routed = 0, numPaths = 0, mismatches = 0;
+        double search = 0, bruteForce = 0;
+        for (const auto& trip : trips) {
+            std::vector<AirlinePath> found;
+            search += timeMs([&]() { found = consult.searchItineraries({std::get<0>(trip)}, {std::get<1>(trip)}, setting.second, std::get<2>(trip)); });
+            std::map<std::vector<Vertex<Airport>*>, std::vector<std::vector<AirlineId>>> expected, actual;
+            bruteForce += timeMs([&]() {
+                expected = bruteForceAirlinePaths(toTarget[std::get<1>(trip)], std::get<0>(trip), std::get<1>(trip), std::get<2>(trip), setting.second, maxFlights);
+            });
+            bool duplicated = false;
+            for (const auto& path : found) duplicated |= !actual.emplace(path.airports, path.airlines).second;
+            routed += !found.empty();
+            numPaths += static_cast<long>(found.size());
+            bool longer = !found.empty() && static_cast<int>(found[0].airports.size()) - 1 > maxFlights;
+            if (duplicated || (longer ? !expected.empty() : expected != actual)) mismatches++;
+        }
+        ok &= mismatches == 0;
+        std::cout << std::setw(22) << setting.first << std::setw(10) << routed << std::setw(10) << numPaths << std::fixed << std::setprecision(1)
+                  << std::setw(14) << search * 1000 / trips.size() << std::setw(18) << bruteForce * 1000 / trips.size()
+                  << std::setw(12) << mismatches << std::endl;
+    }
+    std::cout << "same paths and airlines: " << (ok ? "yes" : "no") << std::endl;
+    return ok;
+}
+
+/**
+ * @brief The maximum trip search as it was before the MS-BFS, a breadth-first search from every airport, kept as the
+ * reference of the diameter check.
+ * @param graph The airport graph.
+ * @param diameter Receives the greatest number of flights between two airports.
+ * @return The (source, target) pair of every longest trip, sorted.
+ */
+static std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> legacyMaxTripPairs(const Graph<Airport>& graph, int& diameter) {
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> pairs;
+    diameter = 0;
+    for (auto airport : graph.getVertexSet()) {
+        std::vector<int> distance(graph.getNumVertex(), -1);
+        std::queue<Vertex<Airport>*> q;
+        q.push(airport);
+        distance[airport->getId()] = 0;
+        std::vector<Vertex<Airport>*> farthest = {airport};
+        int maxDistance = 0;
+        while (!q.empty()) {
+            auto a = q.front();
+            q.pop();
+            for (const auto& flight : a->getAdj()) {
+                auto d = flight.getDest();
+                if (distance[d->getId()] != -1) continue;
+                distance[d->getId()] = distance[a->getId()] + 1;
+                if (distance[d->getId()] > maxDistance) {
+                    maxDistance = distance[d->getId()];
+                    farthest.clear();
+                }
+                farthest.push_back(d);
+                q.push(d);
+            }
+        }
+
+        if (maxDistance > diameter) {
+            diameter = maxDistance;
+            pairs.clear();
+        }
+        if (maxDistance == diameter && diameter > 0) {
+            for (auto target : farthest) pairs.emplace_back(airport, target);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+/**
+ * @brief Measures the maximum trip search with each number of worker threads, and checks the eccentricities and the
+ * longest trips against a breadth-first search from every airport.
+ * @param threadCounts The numbers of threads to measure.
+ * @return True if every search agrees with the reference, otherwise false.
+ */
+static bool benchDiameter(const std::vector<int>& threadCounts) {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    FrozenGraph frozenGraph(parseData.getDataGraph());
+    DiameterSearch diameterSearch(frozenGraph);
+    int n = frozenGraph.getNumVertex();
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", airports: " << n << std::endl;
+    std::cout << std::setw(10) << "search" << std::setw(9) << "threads" << std::setw(10) << "searches" << std::setw(12) << "time (ms)"
+              << std::setw(10) << "diameter" << std::setw(9) << "sources" << std::endl;
+    std::vector<int> allSources;
+    int diameter = 0;
+    for (int threads : threadCounts) {
+        std::vector<int> eccentricities;
+        double time = timeMs([&]() { eccentricities = diameterSearch.eccentricities(threads); });
+        diameter = *std::max_element(eccentricities.begin(), eccentricities.end());
+        allSources.clear();
+        for (int v = 0; v < n; v++) if (eccentricities[v] == diameter) allSources.push_back(v);
+        std::cout << std::setw(10) << "MS-BFS" << std::setw(9) << threads << std::setw(10) << n << std::fixed << std::setprecision(1)
+                  << std::setw(12) << time << std::setw(10) << diameter << std::setw(9) << allSources.size() << std::endl;
+    }
+
+    int legacyDiameter = 0;
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> legacyPairs;
+    double legacyTime = timeMs([&]() { legacyPairs = legacyMaxTripPairs(parseData.getDataGraph(), legacyDiameter); });
+    std::vector<int> legacySources;
+    for (const auto& pair : legacyPairs) legacySources.push_back(pair.first->getId());
+    legacySources.erase(std::unique(legacySources.begin(), legacySources.end()), legacySources.end());
+    std::cout << std::setw(10) << "legacy" << std::setw(9) << 1 << std::setw(10) << n << std::fixed << std::setprecision(1)
+              << std::setw(12) << legacyTime << std::setw(10) << legacyDiameter << std::setw(9) << legacySources.size() << std::endl;
+
+    // The longest trips of the menu must join the same pairs of airports, each with exactly 'diameter' flights
+    Consult consult(parseData.getDataGraph(), parseData.getAirlineRegistry());
+    int tripDiameter = 0;
+    auto trips = consult.searchMaxTripAndCorrespondingPairsOfAirports(tripDiameter);
+    std::vector<std::pair<Vertex<Airport>*, Vertex<Airport>*>> tripPairs;
+    bool validTrips = true;
+    for (const auto& trip : trips) {
+        tripPairs.emplace_back(trip.front(), trip.back());
+        validTrips &= static_cast<int>(trip.size()) == tripDiameter + 1;
+        for (size_t i = 0; i + 1 < trip.size(); i++) validTrips &= parseData.getDataGraph().findEdge(trip[i], trip[i + 1]) != nullptr;
+    }
+    std::sort(tripPairs.begin(), tripPairs.end());
+
+    bool sameSources = allSources == legacySources && diameter == legacyDiameter;
+    bool sameTrips = validTrips && tripDiameter == legacyDiameter && tripPairs == legacyPairs;
+    std::cout << "longest trips: " << trips.size() << ", same sources: " << (sameSources ? "yes" : "no")
+              << ", same trips: " << (sameTrips ? "yes" : "no") << std::endl;
+    return sameSources && sameTrips;
+}
+
+/**
+ * @brief Compares the eccentricity of every airport from a queue-based breadth-first search per airport and from the
+ * bit-parallel multi-source search, both on one thread.
+ * @return True if both searches find the same eccentricities, otherwise false.
+ */
+static bool benchEccentricity() {
+    ParseData parseData("data/airports.csv", "data/airlines.csv", "data/flights.csv");
+    FrozenGraph frozenGraph(parseData.getDataGraph());
+    DiameterSearch diameterSearch(frozenGraph);
+
+    std::vector<int> queued(frozenGraph.getNumVertex()), batched;
+    double queueTime = timeMs([&]() {
+        for (int v = 0; v < frozenGraph.getNumVertex(); v++) queued[v] = diameterSearch.eccentricity(v, SearchContext::local());
+    });
+    double batchTime = timeMs([&]() { batched = diameterSearch.eccentricities(1); });
+
+    bool sameEccentricities = queued == batched;
+    std::cout << "airports: " << frozenGraph.getNumVertex() << ", same eccentricities: " << (sameEccentricities ? "yes" : "no") << std::endl;
+    std::cout << std::setw(12) << "search" << std::setw(12) << "time (ms)" << std::setw(10) << "speedup" << std::endl;
+    std::cout << std::setw(12) << "queue" << std::fixed << std::setprecision(1) << std::setw(12) << queueTime
+              << std::setw(9) << 1.0 << "x" << std::endl;
+    std::cout << std::setw(12) << "MS-BFS" << std::setw(12) << batchTime << std::setw(9) << queueTime / batchTime << "x" << std::endl;
+    return sameEccentricities;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        std::cerr << "Usage: ./bench load [scale...] | ingest [threads...] | startup [scale...] | qps [threads...] | routes [scale...] | astar | kpaths [k] | pareto [labels...] | waypoints [layovers...] | hierarchy | airlines [pairs] | diameter [threads...] | eccentricity" << std::endl;
+        return 1;
+    }
+
+    std::vector<int> numbers;
+    for (size_t i = 1; i < args.size(); i++) numbers.push_back(std::stoi(args[i]));
+
+    if (args[0] == "load") {
+        benchLoad(numbers.empty() ? std::vector<int>{1, 10, 100} : numbers);
+    } else if (args[0] == "ingest") {
+        benchIngest(threadCounts(numbers));
+    } else if (args[0] == "startup") {
+        benchStartup(numbers.empty() ? std::vector<int>{1, 10, 100} : numbers);
+    } else if (args[0] == "qps") {
+        benchQps(threadCounts(numbers));
+    } else if (args[0] == "routes") {
+        benchRoutes(numbers.empty() ? std::vector<int>{1, 10} : numbers);
+    } else if (args[0] == "astar") {
+        benchAStar();
+    } else if (args[0] == "kpaths") {
+        return benchKPaths(numbers.empty() ? 30 : numbers[0]) ? 0 : 1;
+    } else if (args[0] == "pareto") {
+        return benchPareto(numbers.empty() ? std::vector<int>{4, 8, 16, 32, std::numeric_limits<int>::max()} : numbers) ? 0 : 1;
+    } else if (args[0] == "waypoints") {
+        return benchWaypoints(numbers.empty() ? std::vector<int>{2, 4, 8, 12, 16, 24} : numbers) ? 0 : 1;
+    } else if (args[0] == "hierarchy") {
+        return benchHierarchy() ? 0 : 1;
+    } else if (args[0] == "airlines") {
+        return benchAirlines(numbers.empty() ? 200 : numbers[0]) ? 0 : 1;
+    } else if (args[0] == "diameter") {
+        return benchDiameter(threadCounts(numbers)) ? 0 : 1;
+    } else if (args[0] == "eccentricity") {
+        return benchEccentricity() ? 0 : 1;
+    } else {
+        std::cerr << "Unknown benchmark: " << args[0] << std::endl;
+        return 1;
+    }
+    return 0;
+}
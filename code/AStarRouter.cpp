@@ -0,0 +1,104 @@
+#include "AStarRouter.h"
+#include "Utilities.h"
+#include <cmath>
+#include <limits>
+
+// Keeps the heuristics below the costs despite the rounding of the distances
+static const double ESTIMATE_SLACK = 1 - 1e-9;
+
+AStarRouter::AStarRouter(const FrozenGraph& graph) : graph(graph) {
+    locations.reserve(graph.getNumVertex());
+    for (int v = 0; v < graph.getNumVertex(); v++)
+        locations.push_back(graph.getVertex(v)->getInfo().getLocation());
+    for (int e = 0; e < graph.getNumEdges(); e++)
+        longestFlight = max(longestFlight, graph.getDistance(e));
+}
+
+double AStarRouter::estimate(int v, const vector<int>& targets, RouteObjective objective) const {
+    double closest = numeric_limits<double>::max();
+    for (int target : targets) {
+        closest = min(closest, HarversineDistance(locations[v].latitude, locations[v].longitude,
+                                                  locations[target].latitude, locations[target].longitude));
+    }
+    closest *= ESTIMATE_SLACK;
+    if (objective == RouteObjective::DISTANCE)
+        return closest;
+    return longestFlight > 0 ? ceil(closest / longestFlight) : 0;
+}
+
+Route AStarRouter::search(const vector<int>& sources, const vector<int>& targets, RouteObjective objective, bool useHeuristic, SearchContext& context) const {
+    // The targets are reached through a single sink vertex, numbered after the real ones
+    int sink = graph.getNumVertex();
+    context.begin(sink + 1);
+    auto& heap = context.heap();
+    for (int target : targets)
+        context.setMark(target, 1);
+
+    // The estimate of a vertex is computed when it is first reached, as it is pushed again for each shorter path
+    auto push = [&](int v) {
+        pair<double, double> key = context.cost(v);
+        key.first += context.estimate(v);
+        heap.push(key, v);
+    };
+    auto reach = [&](int v) {
+        context.setVisited(v);
+        context.estimate(v) = (useHeuristic && v != sink) ? estimate(v, targets, objective) : 0;
+    };
+
+    for (int source : sources) {
+        if (context.isVisited(source))
+            continue;
+        reach(source);
+        context.cost(source) = {0, 0};
+        context.parent(source) = -1;
+        push(source);
+    }
+
+    Route route;
+    int arrival = -1;
+    while (!heap.empty()) {
+        int v = heap.top().second;
+        heap.pop();
+        if (context.isProcessing(v))
+            continue;
+        context.setProcessing(v, true);
+        route.settled++;
+        if (v == sink)
+            break;
+
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getTarget(e);
+            int node = context.isMarked(w) ? sink : w;
+            if (context.isProcessing(node))
+                continue;
+
+            pair<double, double> cost = context.cost(v);
+            if (objective == RouteObjective::DISTANCE) {
+                cost.first += graph.getDistance(e);
+                cost.second += 1;
+            } else {
+                cost.first += 1;
+                cost.second += graph.getDistance(e);
+            }
+            if (!context.isVisited(node))
+                reach(node);
+            else if (!(cost < context.cost(node)))
+                continue;
+
+            context.cost(node) = cost;
+            context.parent(node) = v;
+            if (node == sink)
+                arrival = w;
+            push(node);
+        }
+    }
+    if (!context.isProcessing(sink))
+        return route;
+
+    route.airports.push_back(graph.getVertex(arrival));
+    for (int v = context.parent(sink); v != -1; v = context.parent(v))
+        route.airports.push_back(graph.getVertex(v));
+    reverse(route.airports.begin(), route.airports.end());
+    route.distance = objective == RouteObjective::DISTANCE ? context.cost(sink).first : context.cost(sink).second;
+    return route;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file AStarRouter.h
+ * @brief Header file containing the cost-optimal route search.
+ *
+ * This file defines the 'AStarRouter' class, which finds the route with the fewest flights or the shortest flown
+ * distance with an A* search. Every flight route is as long as the great-circle distance between its airports,
+ * so the great-circle distance from an airport to the closest target never overestimates the distance left, and
+ * divided by the longest flight route it never overestimates the flights left either. Both heuristics are
+ * consistent, so each airport is settled at most once and the search settles far fewer airports than Dijkstra's
+ * algorithm (the same search without heuristic).
+ */
+
+#ifndef AED_AIRPORTS_ASTARROUTER_H
+#define AED_AIRPORTS_ASTARROUTER_H
+
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+
+/**
+ * @enum RouteObjective
+ * @brief The cost minimized by a route search. The other criterion breaks the ties.
+ */
+enum class RouteObjective {
+    FLIGHTS,    ///< The fewest flights, then the shortest distance.
+    DISTANCE    ///< The shortest distance, then the fewest flights.
+};
+
+/**
+ * @struct Route
+ * @brief The result of a route search.
+ */
+struct Route {
+    vector<Vertex<Airport>*> airports;  ///< The airports of the route, from the source to the target (empty if there is no route).
+    double distance = 0;                ///< The total distance of the route in kilometers.
+    int settled = 0;                    ///< The number of vertices settled by the search.
+};
+
+/**
+ * @class AStarRouter
+ * @brief A* search over the CSR snapshot of the airport graph, using a d-ary heap with lazy deletion.
+ */
+class AStarRouter {
+private:
+    const FrozenGraph& graph;       ///< The CSR snapshot of the airport graph.
+    vector<Coordinates> locations;  ///< The coordinates of each airport.
+    double longestFlight = 0;       ///< The distance of the longest flight route, in kilometers.
+
+    /**
+     * @brief Estimates the cost left from an airport to the closest target.
+     * @param v The vertex ID of the airport.
+     * @param targets The vertex IDs of the targets.
+     * @param objective The minimized cost.
+     * @return A lower bound of the primary cost left (the secondary one is bounded by 0).
+     */
+    double estimate(int v, const vector<int>& targets, RouteObjective objective) const;
+
+public:
+    /**
+     * @brief Constructor for the AStarRouter class.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the router.
+     *
+     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
+     */
+    explicit AStarRouter(const FrozenGraph& graph);
+
+    /**
+     * @brief Searches the best route from any source airport to any target airport.
+     * @param sources The vertex IDs of the starting airports.
+     * @param targets The vertex IDs of the destination airports. A source that is also a target is only reached
+     * again through a round trip.
+     * @param objective The minimized cost.
+     * @param useHeuristic True for A*, false for Dijkstra's algorithm.
+     * @param context The search context holding the costs, parents and heap of the search.
+     * @return The best route, with no airport if no target is reachable.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges, usually much less with the heuristic.
+     */
+    Route search(const vector<int>& sources, const vector<int>& targets, RouteObjective objective, bool useHeuristic, SearchContext& context) const;
+};
+
+#endif //AED_AIRPORTS_ASTARROUTER_H
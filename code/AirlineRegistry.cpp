@@ -0,0 +1,72 @@
+#include "AirlineRegistry.h"
+using namespace std;
+
+void AirlineSet::insert(AirlineId id) {
+    words[id >> 6] |= uint64_t(1) << (id & 63);
+}
+
+void AirlineSet::assign(const vector<AirlineId>& ids) {
+    fill(words.begin(), words.end(), 0);
+    for (auto id : ids)
+        insert(id);
+}
+
+bool AirlineSet::contains(AirlineId id) const {
+    return (words[id >> 6] >> (id & 63)) & 1;
+}
+
+void AirlineSet::intersectWith(const AirlineSet& other) {
+    for (size_t i = 0; i < words.size(); i++)
+        words[i] &= other.words[i];
+}
+
+bool AirlineSet::empty() const {
+    for (auto word : words)
+        if (word != 0) return false;
+    return true;
+}
+
+int AirlineSet::count() const {
+    int total = 0;
+    for (auto word : words)
+        total += __builtin_popcountll(word);
+    return total;
+}
+
+vector<AirlineId> AirlineSet::toIds() const {
+    vector<AirlineId> ids;
+    for (size_t i = 0; i < words.size(); i++) {
+        uint64_t word = words[i];
+        while (word != 0) {
+            ids.push_back(static_cast<AirlineId>(i * 64 + __builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+    return ids;
+}
+
+AirlineId AirlineRegistry::addAirline(const Airline& airline) {
+    auto it = idByCode.find(airline.getCode());
+    if (it != idByCode.end())
+        return it->second;
+
+    AirlineId id = static_cast<AirlineId>(airlines.size());
+    airlines.push_back(airline);
+    idByCode.emplace(airline.getCode(), id);
+    return id;
+}
+
+bool AirlineRegistry::findAirlineId(const string& code, AirlineId& id) const {
+    auto it = idByCode.find(code);
+    if (it == idByCode.end())
+        return false;
+    id = it->second;
+    return true;
+}
+
+set<Airline> AirlineRegistry::toAirlines(const vector<AirlineId>& ids) const {
+    set<Airline> res;
+    for (auto id : ids)
+        res.insert(airlines[id]);
+    return res;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file AirlineRegistry.h
+ * @brief Header file containing the airline interning structures.
+ *
+ * This file defines the 'AirlineRegistry' class, which assigns a dense 16-bit ID to every airline so that
+ * flight routes can refer to airlines by ID instead of storing full 'Airline' objects, and the 'AirlineSet'
+ * class, a bitset over those IDs whose intersections are computed word by word.
+ */
+
+#ifndef AED_AIRPORTS_AIRLINEREGISTRY_H
+#define AED_AIRPORTS_AIRLINEREGISTRY_H
+
+#include "Data.h"
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+
+/**
+ * @brief Dense identifier of an airline inside an AirlineRegistry.
+ */
+typedef uint16_t AirlineId;
+
+/**
+ * @class AirlineSet
+ * @brief Set of airline IDs stored as a bitset.
+ */
+class AirlineSet {
+private:
+    std::vector<uint64_t> words;    ///< The bits of the set, airline ID 'id' is bit (id % 64) of words[id / 64].
+
+public:
+    /**
+     * @brief Default constructor for the AirlineSet class, creates an empty set.
+     */
+    AirlineSet() {}
+
+    /**
+     * @brief Constructor for the AirlineSet class, creates an empty set able to hold the given number of airlines.
+     * @param numAirlines The number of airline IDs the set can hold.
+     */
+    explicit AirlineSet(int numAirlines) : words((numAirlines + 63) / 64, 0) {}
+
+    /**
+     * @brief Adds an airline ID to the set.
+     * @param id The airline ID to add.
+     */
+    void insert(AirlineId id);
+
+    /**
+     * @brief Replaces the content of the set by the given airline IDs, reusing the allocated words.
+     * @param ids The airline IDs to store.
+     */
+    void assign(const std::vector<AirlineId>& ids);
+
+    /**
+     * @brief Checks if an airline ID belongs to the set.
+     * @param id The airline ID to check.
+     * @return True if the airline belongs to the set, otherwise false.
+     */
+    bool contains(AirlineId id) const;
+
+    /**
+     * @brief Keeps only the airline IDs that also belong to the other set (word-wise AND).
+     * @param other The set to intersect with.
+     *
+     * Time Complexity: O(A/64) where A stands for the number of airlines.
+     */
+    void intersectWith(const AirlineSet& other);
+
+    /**
+     * @brief Checks if the set is empty.
+     * @return True if no airline belongs to the set, otherwise false.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Counts the airline IDs in the set.
+     * @return The number of airlines in the set.
+     */
+    int count() const;
+
+    /**
+     * @brief Lists the airline IDs of the set in increasing order.
+     * @return Vector with the airline IDs.
+     */
+    std::vector<AirlineId> toIds() const;
+};
+
+/**
+ * @class AirlineRegistry
+ * @brief Interns airlines, assigning a dense ID to each distinct airline code.
+ */
+class AirlineRegistry {
+private:
+    std::vector<Airline> airlines;                          ///< The airline of each airline ID.
+    std::unordered_map<std::string, AirlineId> idByCode;    ///< Index from airline code to airline ID.
+
+public:
+    /**
+     * @brief Registers an airline, assigning it the next free ID.
+     * @param airline The airline to register.
+     * @return The ID of the airline (the existing one if its code was already registered).
+     */
+    AirlineId addAirline(const Airline& airline);
+
+    /**
+     * @brief Finds the ID of an airline using its code.
+     * @param code The code of the airline.
+     * @param id [out] The ID of the airline, if found.
+     * @return True if the airline is registered, otherwise false.
+     *
+     * Time Complexity: O(1) on average.
+     */
+    bool findAirlineId(const std::string& code, AirlineId& id) const;
+
+    /**
+     * @brief Retrieves the airline of an ID.
+     * @param id The airline ID.
+     * @return Constant reference to the airline.
+     */
+    const Airline& getAirline(AirlineId id) const { return airlines[id]; }
+
+    /**
+     * @brief Retrieves all the registered airlines, indexed by their ID.
+     * @return Constant reference to the vector of airlines.
+     */
+    const std::vector<Airline>& getAirlines() const { return airlines; }
+
+    /**
+     * @brief Retrieves the number of registered airlines.
+     * @return The number of airlines.
+     */
+    int size() const { return static_cast<int>(airlines.size()); }
+
+    /**
+     * @brief Converts a list of airline IDs to the corresponding airlines.
+     * @param ids The airline IDs.
+     * @return Set with the airlines.
+     */
+    std::set<Airline> toAirlines(const std::vector<AirlineId>& ids) const;
+};
+
+#endif //AED_AIRPORTS_AIRLINEREGISTRY_H
@@ -0,0 +1,257 @@
+#include "AirlineRouter.h"
+#include <functional>
+#include <tuple>
+
+AirlineRouter::AirlineRouter(const FrozenGraph& graph) : graph(graph) {
+    int numEntries = graph.getNumEdges() == 0 ? 0 : static_cast<int>(graph.airlinesEnd(graph.getNumEdges() - 1) - graph.airlinesBegin(0));
+    const AirlineId* firstEntry = numEntries == 0 ? nullptr : graph.airlinesBegin(0);
+
+    // Sort the (destination, airline) pair of every airline entry, each distinct pair being an arrival state
+    vector<tuple<int, AirlineId, int>> entries;
+    entries.reserve(numEntries);
+    for (int e = 0; e < graph.getNumEdges(); e++) {
+        for (auto airline = graph.airlinesBegin(e); airline != graph.airlinesEnd(e); airline++) {
+            entries.emplace_back(graph.getTarget(e), *airline, static_cast<int>(airline - firstEntry));
+            numAirlines = max(numAirlines, *airline + 1);
+        }
+    }
+    sort(entries.begin(), entries.end());
+
+    entryStates.resize(numEntries);
+    for (size_t i = 0; i < entries.size(); i++) {
+        int vertex = get<0>(entries[i]);
+        AirlineId airline = get<1>(entries[i]);
+        if (i == 0 || vertex != get<0>(entries[i - 1]) || airline != get<1>(entries[i - 1])) {
+            stateVertices.push_back(vertex);
+            stateAirlines.push_back(airline);
+        }
+        entryStates[get<2>(entries[i])] = static_cast<int>(stateVertices.size()) - 1;
+    }
+
+    // Group the airline entries by (source, airline), then attach each group to the arrival state of the same pair
+    vector<tuple<int, AirlineId, int, int>> departures;
+    departures.reserve(numEntries);
+    for (int v = 0; v < graph.getNumVertex(); v++) {
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            for (auto airline = graph.airlinesBegin(e); airline != graph.airlinesEnd(e); airline++)
+                departures.emplace_back(v, *airline, graph.getTarget(e), entryStates[airline - firstEntry]);
+        }
+    }
+    sort(departures.begin(), departures.end());
+
+    departureOffsets.assign(stateVertices.size() + 1, 0);
+    size_t next = 0;
+    for (size_t state = 0; state < stateVertices.size(); state++) {
+        auto key = make_pair(stateVertices[state], stateAirlines[state]);
+        while (next < departures.size() && make_pair(get<0>(departures[next]), get<1>(departures[next])) < key)
+            next++;
+        while (next < departures.size() && make_pair(get<0>(departures[next]), get<1>(departures[next])) == key) {
+            departureTargets.push_back(get<2>(departures[next]));
+            departureStates.push_back(get<3>(departures[next]));
+            next++;
+        }
+        departureOffsets[state + 1] = static_cast<int>(departureTargets.size());
+    }
+}
+
+vector<AirlinePath> AirlineRouter::search(const vector<int>& sources, const vector<int>& targets, const vector<int>& layovers,
+                                        const AirlineConstraints& constraints, SearchContext& context) const {
+    vector<bool> usable(numAirlines, true);
+    for (int airline = 0; airline < numAirlines; airline++) {
+        if (!constraints.allowed.empty() && !constraints.allowed.contains(airline))
+            usable[airline] = false;
+        if (!constraints.denied.empty() && constraints.denied.contains(airline))
+            usable[airline] = false;
+    }
+
+    // A search state is ((arrival state or starting airport) * (layovers + 1) + layovers visited) * changeLayers + changes,
+    // where the starting airport 'v' stands for the base state numArrivalStates + v
+    bool limitedChanges = constraints.maxChanges >= 0;
+    int changeLayers = limitedChanges ? constraints.maxChanges + 1 : 1;
+    int legLayers = static_cast<int>(layovers.size()) + 1;
+    int numArrivalStates = static_cast<int>(stateVertices.size());
+    int numStates = (numArrivalStates + graph.getNumVertex()) * legLayers * changeLayers;
+    auto encode = [&](int base, int leg, int changes) { return (base * legLayers + leg) * changeLayers + changes; };
+    auto vertexOf = [&](int state) {
+        int base = state / (legLayers * changeLayers);
+        return base < numArrivalStates ? stateVertices[base] : base - numArrivalStates;
+    };
+    auto airlineOf = [&](int state) {
+        int base = state / (legLayers * changeLayers);
+        return base < numArrivalStates ? static_cast<int>(stateAirlines[base]) : -1;
+    };
+
+    context.begin(numStates);
+    vector<int>& q = context.queue();
+    vector<pair<int, int>>& links = context.links();
+    for (int target : targets)
+        context.setMark(target, 1);
+    for (int source : sources) {
+        int state = encode(numArrivalStates + source, 0, 0);
+        if (context.isVisited(state))
+            continue;
+        context.setVisited(state);
+        context.distance(state) = 0;
+        context.parent(state) = -1;
+        q.push_back(state);
+    }
+
+    // Arrivals at a target are never expanded, each one is kept as (last state before the target, arrival state)
+    vector<pair<int, int>> arrivals;
+    int arrivalLevel = -1;
+    const AirlineId* firstEntry = graph.getNumEdges() == 0 ? nullptr : graph.airlinesBegin(0);
+    for (size_t head = 0; head < q.size(); head++) {
+        int x = q[head];
+        int d = context.distance(x);
+        if (arrivalLevel != -1 && d >= arrivalLevel)
+            break;
+
+        int u = vertexOf(x);
+        int airline = airlineOf(x);
+        int leg = (x / changeLayers) % legLayers;
+        int changes = x % changeLayers;
+
+        // Visits the arrival state 'next' at airport 'w', flown with 'entryAirline'
+        auto relax = [&](int w, AirlineId entryAirline, int next) {
+            int nextChanges = changes;
+            if (airline != -1 && entryAirline != airline && limitedChanges) {
+                if (changes == constraints.maxChanges)
+                    return;
+                nextChanges++;
+            }
+            int nextLeg = (leg < legLayers - 1 && w == layovers[leg]) ? leg + 1 : leg;
+            int y = encode(next, nextLeg, nextChanges);
+
+            if (leg == legLayers - 1 && context.isMarked(w)) {
+                arrivalLevel = d + 1;
+                arrivals.emplace_back(x, y);
+                return;
+            }
+            if (arrivalLevel != -1)
+                return;
+            if (!context.isVisited(y)) {
+                context.setVisited(y);
+                context.distance(y) = d + 1;
+                context.parent(y) = -1;
+                q.push_back(y);
+            }
+            if (context.distance(y) == d + 1) {
+                links.emplace_back(x, context.parent(y));
+                context.parent(y) = static_cast<int>(links.size()) - 1;
+            }
+        };
+
+        if (airline != -1 && limitedChanges && changes == constraints.maxChanges) {
+            // No airline change left: only the flights of the current airline
+            int base = x / (legLayers * changeLayers);
+            for (int i = departureOffsets[base]; i < departureOffsets[base + 1]; i++)
+                relax(departureTargets[i], static_cast<AirlineId>(airline), departureStates[i]);
+        } else {
+            for (int e = graph.edgesBegin(u); e < graph.edgesEnd(u); e++) {
+                for (auto entry = graph.airlinesBegin(e); entry != graph.airlinesEnd(e); entry++) {
+                    if (usable[*entry])
+                        relax(graph.getTarget(e), *entry, entryStates[entry - firstEntry]);
+                }
+            }
+        }
+    }
+
+    // Unwind the predecessor states airport by airport: the states of each position of an airport path are unwound
+    // together, so each airport path is listed once however many airline sequences fly it
+    vector<AirlinePath> paths;
+    if (arrivals.empty())
+        return paths;
+    int flights = arrivalLevel;
+    sort(arrivals.begin(), arrivals.end(), [&](const pair<int, int>& a, const pair<int, int>& b) {
+        return make_tuple(vertexOf(a.second), a.second, a.first) < make_tuple(vertexOf(b.second), b.second, b.first);
+    });
+
+    vector<vector<int>> layers(flights + 1);    // The states of each position of the airport path being unwound, sorted
+    size_t arrivalsBegin = 0, arrivalsEnd = 0;  // The arrivals at the target of that path
+    auto parents = [&](int position, int state, vector<int>& result) {
+        if (position == flights) {
+            // The arrivals at the same target are sorted by arrival state
+            auto it = lower_bound(arrivals.begin() + arrivalsBegin, arrivals.begin() + arrivalsEnd, state,
+                                  [](const pair<int, int>& arrival, int s) { return arrival.second < s; });
+            for (; it != arrivals.begin() + arrivalsEnd && it->second == state; ++it)
+                result.push_back(it->first);
+        } else {
+            for (int link = context.parent(state); link != -1; link = links[link].second)
+                result.push_back(links[link].first);
+        }
+    };
+
+    // Keeps the states of each position on some chain from a source to the target, then lists the airlines of each flight
+    auto addPath = [&]() {
+        vector<vector<int>> kept = layers;
+        vector<int> found;
+        for (int position = 1; position <= flights; position++) {
+            vector<int> reached;
+            for (int state : kept[position]) {
+                found.clear();
+                parents(position, state, found);
+                if (any_of(found.begin(), found.end(), [&](int parent) { return binary_search(kept[position - 1].begin(), kept[position - 1].end(), parent); }))
+                    reached.push_back(state);
+            }
+            kept[position] = move(reached);
+        }
+        for (int position = flights - 1; position >= 0; position--) {
+            found.clear();
+            for (int state : kept[position + 1])
+                parents(position + 1, state, found);
+            sort(found.begin(), found.end());
+            vector<int> used;
+            set_intersection(kept[position].begin(), kept[position].end(), found.begin(), found.end(), back_inserter(used));
+            kept[position] = move(used);
+        }
+
+        AirlinePath path;
+        for (int position = 0; position <= flights; position++) {
+            path.airports.push_back(graph.getVertex(vertexOf(kept[position][0])));
+            if (position == 0)
+                continue;
+            vector<AirlineId> airlines;
+            for (int state : kept[position])
+                airlines.push_back(static_cast<AirlineId>(airlineOf(state)));
+            sort(airlines.begin(), airlines.end());
+            airlines.erase(unique(airlines.begin(), airlines.end()), airlines.end());
+            path.airlines.push_back(move(airlines));
+        }
+        paths.push_back(move(path));
+    };
+
+    // Every state of a position has a predecessor one flight closer to the sources, so each group of predecessors
+    // at the same airport extends to at least one path
+    function<void(int)> unwind = [&](int position) {
+        if (position == 0) {
+            addPath();
+            return;
+        }
+        vector<pair<int, int>> candidates;
+        vector<int> found;
+        for (int state : layers[position]) {
+            found.clear();
+            parents(position, state, found);
+            for (int parent : found)
+                candidates.emplace_back(vertexOf(parent), parent);
+        }
+        sort(candidates.begin(), candidates.end());
+        candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+        for (size_t begin = 0, end; begin < candidates.size(); begin = end) {
+            layers[position - 1].clear();
+            for (end = begin; end < candidates.size() && candidates[end].first == candidates[begin].first; end++)
+                layers[position - 1].push_back(candidates[end].second);
+            unwind(position - 1);
+        }
+    };
+    for (arrivalsBegin = 0; arrivalsBegin < arrivals.size(); arrivalsBegin = arrivalsEnd) {
+        layers[flights].clear();
+        int target = vertexOf(arrivals[arrivalsBegin].second);
+        for (arrivalsEnd = arrivalsBegin; arrivalsEnd < arrivals.size() && vertexOf(arrivals[arrivalsEnd].second) == target; arrivalsEnd++) {
+            if (layers[flights].empty() || layers[flights].back() != arrivals[arrivalsEnd].second)
+                layers[flights].push_back(arrivals[arrivalsEnd].second);
+        }
+        unwind(flights);
+    }
+    return paths;
+}
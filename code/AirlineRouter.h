@@ -0,0 +1,81 @@
+/**
+ * @file AirlineRouter.h
+ * @brief Header file containing the airline-constrained route search.
+ *
+ * Filtering the smallest paths of the airport graph by airline misses every itinerary that needs one more
+ * flight to stay on a single carrier. The 'AirlineRouter' class searches a layered graph instead, whose states
+ * are (airport, airline of the arriving flight, airline changes so far, custom layovers visited so far), so the
+ * breadth-first search directly finds the itineraries with the fewest flights that satisfy the constraints.
+ * States only exist for the airlines actually flying into each airport, and the flights of each airline leaving
+ * each airport are indexed as well, so that a state that cannot change airline only scans the flights of its own.
+ */
+
+#ifndef AED_AIRPORTS_AIRLINEROUTER_H
+#define AED_AIRPORTS_AIRLINEROUTER_H
+
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+
+/**
+ * @struct AirlineConstraints
+ * @brief Restrictions on the airlines of an itinerary.
+ */
+struct AirlineConstraints {
+    AirlineSet allowed;     ///< The airlines that may be flown (sized for the airline registry), every airline if empty.
+    AirlineSet denied;      ///< The airlines that must not be flown (sized for the airline registry).
+    int maxChanges = 0;     ///< The maximum number of airline changes (0 for a single airline), negative for no limit.
+};
+
+/**
+ * @struct AirlinePath
+ * @brief A path through the airport graph together with the airlines each of its flights can be flown with.
+ */
+struct AirlinePath {
+    vector<Vertex<Airport>*> airports;  ///< The airports of the path, from the source to the target.
+    vector<vector<AirlineId>> airlines; ///< The airlines of each flight, sorted: airlines[i] flies from airports[i] to airports[i + 1] in some itinerary satisfying the constraints.
+};
+
+/**
+ * @class AirlineRouter
+ * @brief Searches the itineraries with the fewest flights under airline constraints.
+ */
+class AirlineRouter {
+private:
+    const FrozenGraph& graph;           ///< The CSR snapshot of the airport graph.
+    int numAirlines = 0;                ///< One more than the largest airline ID of the graph.
+    vector<int> entryStates;            ///< The arrival state of each airline entry of the edges (parallel to the airline IDs of the graph).
+    vector<int> stateVertices;          ///< The airport of each arrival state.
+    vector<AirlineId> stateAirlines;    ///< The airline of each arrival state.
+    vector<int> departureOffsets;       ///< The flights of the airline of state 's' leaving its airport are in [departureOffsets[s], departureOffsets[s + 1]).
+    vector<int> departureTargets;       ///< The destination vertex ID of each of those flights.
+    vector<int> departureStates;        ///< The arrival state of each of those flights.
+
+public:
+    /**
+     * @brief Constructor for the AirlineRouter class, numbers the (airport, airline) arrival states of the graph.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the router.
+     *
+     * Time Complexity: O(F*log(F)) where F stands for the number of (flight route, airline) pairs.
+     */
+    explicit AirlineRouter(const FrozenGraph& graph);
+
+    /**
+     * @brief Searches every airport path with the fewest flights from any source airport to any target airport that some
+     * itinerary satisfying the constraints flies.
+     * @param sources The vertex IDs of the starting airports.
+     * @param targets The vertex IDs of the destination airports.
+     * @param layovers The vertex IDs of the airports the itineraries must go through, in order (may be empty).
+     * @param constraints The airline constraints of the itineraries.
+     * @param context The search context used by the breadth-first search.
+     * @return The airport paths, each listed once with the airlines of each of its flights, empty if no itinerary
+     * satisfies the constraints.
+     *
+     * Time Complexity: O(C*(L+1)*sum(s(v)*f(v))) where C stands for the allowed airline changes plus one, L for the layovers,
+     * s(v) for the airlines flying into airport v and f(v) for the (flight route, airline) pairs leaving it, plus
+     * O(P*F*S) where P stands for the airport paths, F for their flights and S for the states of a position.
+     */
+    vector<AirlinePath> search(const vector<int>& sources, const vector<int>& targets, const vector<int>& layovers,
+                               const AirlineConstraints& constraints, SearchContext& context) const;
+};
+
+#endif //AED_AIRPORTS_AIRLINEROUTER_H
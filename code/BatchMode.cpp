@@ -0,0 +1,293 @@
+#include "BatchMode.h"
+#include <chrono>
+#include <iomanip>
+
+static const size_t CHUNK_SIZE = 4096;
+
+// Above this many trips with the fewest flights, the shortest one is searched leg by leg instead of scanned
+static const uint64_t MAX_SCANNED_PATHS = 256;
+
+static string JsonString(const string& text) {
+    string res = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            res += escaped;
+        } else {
+            res += c;
+        }
+    }
+    return res + "\"";
+}
+
+static double Percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(p * sorted.size());
+    return sorted[min(rank, sorted.size() - 1)];
+}
+
+BatchMode::BatchMode(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry, const BatchOptions& options)
+        : options(options), engine(dataGraph, airlineRegistry, options.threads) {}
+
+vector<Vertex<Airport>*> BatchMode::resolveEndpoint(const string& text) {
+    size_t slash = text.find('/');
+    if (slash == string::npos) {
+        Vertex<Airport>* airport = engine.getConsult().findAirportByCode(text);
+        if (airport == nullptr) return {};
+        return {airport};
+    }
+
+    string city = TrimString(text.substr(0, slash));
+    string country = TrimString(text.substr(slash + 1));
+    string key = RemoveSpaces(ToLower(city)) + "/" + RemoveSpaces(ToLower(country));
+    auto it = cityAirports.find(key);
+    if (it == cityAirports.end())
+        it = cityAirports.emplace(key, engine.getConsult().getAirportsInACityAndCountry(city, country)).first;
+    return it->second;
+}
+
+BatchMode::Request BatchMode::parseRequest(const string& line, long id) {
+    Request request;
+    request.id = id;
+
+    vector<string> fields;
+    stringstream ss(line);
+    string field;
+    while (getline(ss, field, ','))
+        fields.push_back(TrimString(field));
+
+    if (fields.size() < 2 || fields.size() > 4) {
+        request.error = "invalid_request";
+        return request;
+    }
+    request.sourceText = fields[0];
+    request.destinationText = fields[1];
+
+    if (fields.size() > 2) {
+        string sameAirline = ToLower(fields[2]);
+        if (sameAirline == "1" || sameAirline == "true" || sameAirline == "yes") {
+            request.sameAirline = true;
+        } else if (!(sameAirline.empty() || sameAirline == "0" || sameAirline == "false" || sameAirline == "no")) {
+            request.error = "invalid_request";
+            return request;
+        }
+    }
+
+    request.source = resolveEndpoint(request.sourceText);
+    if (request.source.empty()) {
+        request.error = "unknown_source";
+        return request;
+    }
+    request.destination = resolveEndpoint(request.destinationText);
+    if (request.destination.empty()) {
+        request.error = "unknown_destination";
+        return request;
+    }
+
+    if (fields.size() > 3) {
+        stringstream layovers(fields[3]);
+        string code;
+        while (getline(layovers, code, ';')) {
+            code = TrimString(code);
+            if (code.empty()) continue;
+            Vertex<Airport>* layover = engine.getConsult().findAirportByCode(code);
+            if (layover == nullptr) {
+                request.error = "unknown_layover";
+                return request;
+            }
+            request.layovers.push_back(layover);
+        }
+    }
+    return request;
+}
+
+BatchMode::Result BatchMode::answer(const Request& request, Consult& c) {
+    auto start = chrono::steady_clock::now();
+    Result result;
+    if (request.sameAirline) {
+        vector<Trip> trips = c.getBestPathsSameAirlines(request.source, request.destination, request.layovers);
+        result.options = static_cast<int>(trips.size());
+        size_t best = 0;
+        for (size_t i = 1; i < trips.size(); i++) {
+            if (trips[i].second.second < trips[best].second.second)
+                best = i;
+        }
+        if (!trips.empty())
+            result.best = move(trips[best]);
+    } else {
+        // Few trips are scanned one at a time, otherwise the shortest one is searched leg by leg however many trips there are
+        WaypointPaths paths = c.searchWaypointPaths(request.source, request.destination, request.layovers);
+        uint64_t count = paths.countPaths();
+        result.options = static_cast<int>(min<uint64_t>(count, numeric_limits<int>::max()));
+        if (count > 0 && count <= MAX_SCANNED_PATHS) {
+            for (const auto& path : paths) {
+                double distance = 0.0;
+                for (auto it = path.begin(); it != path.end() - 1; ++it)
+                    distance += c.getDistanceBetweenAirports(*it, *(it + 1));
+                if (result.best.second.first.empty() || distance < result.best.second.second)
+                    result.best = { set<Airline>(), { path, distance } };
+            }
+        } else if (count > 0) {
+            result.best = move(c.getShortestBestPathAllAirlines(request.source, request.destination, request.layovers)[0]);
+        }
+    }
+    result.latency = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void BatchMode::writeResult(ostream& out, const Request& request, const Result* result) const {
+    string status = !request.error.empty() ? request.error : (result->options > 0 ? "ok" : "no_route");
+    static const vector<Vertex<Airport>*> noPath;
+    static const set<Airline> noAirlines;
+    bool found = result != nullptr && result->options > 0;
+    const auto& path = found ? result->best.second.first : noPath;
+    const auto& airlines = found ? result->best.first : noAirlines;
+
+    if (options.jsonl) {
+        out << "{\"id\":" << request.id << ",\"source\":" << JsonString(request.sourceText)
+            << ",\"destination\":" << JsonString(request.destinationText) << ",\"status\":\"" << status << "\"";
+        if (found) {
+            out << ",\"layovers\":" << path.size() - 2 << ",\"options\":" << result->options
+                << ",\"distance_km\":" << fixed << setprecision(2) << result->best.second.second << ",\"path\":[";
+            for (size_t i = 0; i < path.size(); i++)
+                out << (i > 0 ? "," : "") << JsonString(path[i]->getInfo().getCode());
+            out << "],\"airlines\":[";
+            for (auto it = airlines.begin(); it != airlines.end(); ++it)
+                out << (it != airlines.begin() ? "," : "") << JsonString(it->getCode());
+            out << "]";
+        }
+        if (result != nullptr)
+            out << ",\"latency_us\":" << fixed << setprecision(1) << result->latency;
+        out << "}\n";
+        return;
+    }
+
+    out << request.id << "," << request.sourceText << "," << request.destinationText << "," << status << ",";
+    if (found) {
+        out << path.size() - 2 << "," << result->options << "," << fixed << setprecision(2) << result->best.second.second << ",";
+        for (size_t i = 0; i < path.size(); i++)
+            out << (i > 0 ? "-" : "") << path[i]->getInfo().getCode();
+        out << ",";
+        for (auto it = airlines.begin(); it != airlines.end(); ++it)
+            out << (it != airlines.begin() ? ";" : "") << it->getCode();
+        out << ",";
+    } else {
+        out << ",,,,,";
+    }
+    if (result != nullptr)
+        out << fixed << setprecision(1) << result->latency;
+    out << "\n";
+}
+
+int BatchMode::run() {
+    ifstream inputFile;
+    istream* in = &cin;
+    if (options.input != "-") {
+        inputFile.open(options.input);
+        if (!inputFile.is_open()) {
+            cerr << "Error: Unable to open file " << options.input << endl;
+            return 1;
+        }
+        in = &inputFile;
+    }
+
+    ofstream outputFile;
+    ostream* out = &cout;
+    if (options.output != "-") {
+        outputFile.open(options.output);
+        if (!outputFile.is_open()) {
+            cerr << "Error: Unable to open file " << options.output << endl;
+            return 1;
+        }
+        out = &outputFile;
+    }
+
+    if (!options.jsonl)
+        *out << "id,source,destination,status,layovers,options,distance_km,path,airlines,latency_us\n";
+
+    auto start = chrono::steady_clock::now();
+    vector<double> latencies;
+    long requests = 0, failed = 0;
+    bool firstLine = true;
+    string line;
+
+    // The workers answer a chunk while the next one is read and the previous one is written
+    vector<Request> pending;
+    vector<future<Result>> pendingResults;
+    while (true) {
+        vector<Request> chunk;
+        while (chunk.size() < CHUNK_SIZE && getline(*in, line)) {
+            line = TrimString(line);
+            if (line.empty()) continue;
+            if (firstLine) {
+                firstLine = false;
+                if (ToLower(line).rfind("source", 0) == 0) continue;
+            }
+            chunk.push_back(parseRequest(line, ++requests));
+        }
+
+        vector<future<Result>> results;
+        for (const auto& request : chunk) {
+            if (request.error.empty()) {
+                const Request* r = &request;
+                results.push_back(engine.submit([r](Consult& c) { return answer(*r, c); }));
+            }
+        }
+
+        size_t next = 0;
+        for (const auto& request : pending) {
+            if (!request.error.empty()) {
+                failed++;
+                writeResult(*out, request, nullptr);
+                continue;
+            }
+            Result result = pendingResults[next++].get();
+            latencies.push_back(result.latency);
+            writeResult(*out, request, &result);
+        }
+
+        if (chunk.empty()) break;
+        pending = move(chunk);
+        pendingResults = move(results);
+    }
+    out->flush();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    sort(latencies.begin(), latencies.end());
+    cerr << "Answered " << requests << " requests (" << failed << " rejected) in " << fixed << setprecision(2) << seconds
+         << " s with " << engine.getNumThreads() << " thread(s), " << setprecision(1) << requests / max(seconds, 1e-9) << " requests/s" << endl;
+    cerr << "Latency (us): p50 " << Percentile(latencies, 0.50) << ", p90 " << Percentile(latencies, 0.90)
+         << ", p99 " << Percentile(latencies, 0.99) << ", p99.9 " << Percentile(latencies, 0.999)
+         << ", max " << (latencies.empty() ? 0 : latencies.back()) << endl;
+    return 0;
+}
+
+bool BatchMode::parseArguments(const vector<string>& args, BatchOptions& options) {
+    bool batch = false;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (i + 1 >= args.size())
+            return false;
+        const string& value = args[++i];
+
+        if (args[i - 1] == "--batch") {
+            options.input = value;
+            batch = true;
+        } else if (args[i - 1] == "--output") {
+            options.output = value;
+        } else if (args[i - 1] == "--format") {
+            if (value != "csv" && value != "jsonl") return false;
+            options.jsonl = (value == "jsonl");
+        } else if (args[i - 1] == "--threads") {
+            // At most 9 digits, so the count always fits in an unsigned int
+            if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != string::npos) return false;
+            options.threads = static_cast<unsigned>(stoul(value));
+        } else {
+            return false;
+        }
+    }
+    return batch;
+}
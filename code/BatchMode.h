@@ -0,0 +1,124 @@
+/**
+ * @file BatchMode.h
+ * @brief Header file containing the non-interactive batch route query mode.
+ *
+ * This file defines the 'BatchMode' class, which reads route requests (one per line) from a file or the standard
+ * input, answers them in parallel with the same best flight search as the interactive menus, and writes one
+ * result per request, in input order, as CSV or JSON lines. Requests are streamed in fixed-size chunks, so the
+ * memory use does not depend on the number of requests. Latency percentiles are reported at the end.
+ *
+ * Request format: source,destination[,same_airline[,layovers]]
+ *   - source / destination: an airport code (e.g. "OPO") or a city as "City/Country" (e.g. "Porto/Portugal").
+ *   - same_airline: "1", "true" or "yes" to only accept flights operated by a single airline (default: no).
+ *   - layovers: airport codes the flights must go through, in order, separated by ';' (default: none).
+ * A first line starting with "source" is treated as a header and skipped.
+ */
+
+#ifndef AED_AIRPORTS_BATCHMODE_H
+#define AED_AIRPORTS_BATCHMODE_H
+
+#include "QueryEngine.h"
+#include <iostream>
+
+/**
+ * @struct BatchOptions
+ * @brief Command line options of the batch mode.
+ */
+struct BatchOptions {
+    std::string input = "-";    ///< Path of the requests file, "-" for the standard input.
+    std::string output = "-";   ///< Path of the results file, "-" for the standard output.
+    bool jsonl = false;         ///< Indicates if the results are written as JSON lines instead of CSV.
+    unsigned threads = 0;       ///< Number of worker threads (0 uses every hardware thread).
+};
+
+/**
+ * @class BatchMode
+ * @brief Answers a stream of route requests without user interaction.
+ */
+class BatchMode {
+private:
+    /**
+     * @struct Request
+     * @brief A parsed route request.
+     */
+    struct Request {
+        long id;                                ///< The number of the request in the input (starting at 1).
+        std::string sourceText;                 ///< The source as written in the request.
+        std::string destinationText;            ///< The destination as written in the request.
+        vector<Vertex<Airport>*> source;        ///< The source airports.
+        vector<Vertex<Airport>*> destination;   ///< The destination airports.
+        vector<Vertex<Airport>*> layovers;      ///< The custom layover airports.
+        bool sameAirline = false;               ///< Indicates if every leg must be operated by a common airline.
+        std::string error;                      ///< The status of a request that cannot be answered, empty otherwise.
+    };
+
+    /**
+     * @struct Result
+     * @brief The answer to a route request.
+     */
+    struct Result {
+        int options = 0;    ///< The number of trips with the fewest layovers.
+        Trip best;          ///< The shortest of those trips.
+        double latency = 0; ///< The time spent answering the request, in microseconds.
+    };
+
+    BatchOptions options;                                               ///< The options of the batch.
+    QueryEngine engine;                                                 ///< Engine answering the requests, whose consult also resolves their airports.
+    unordered_map<std::string, vector<Vertex<Airport>*>> cityAirports;  ///< Cache of the airports of each requested city.
+
+    /**
+     * @brief Resolves an endpoint of a request to its airports.
+     * @param text An airport code or a "City/Country" pair.
+     * @return The airports, empty if none matches.
+     */
+    vector<Vertex<Airport>*> resolveEndpoint(const std::string& text);
+
+    /**
+     * @brief Parses a request line.
+     * @param line The line of the request.
+     * @param id The number of the request.
+     * @return The parsed request, with its error status set if it cannot be answered.
+     */
+    Request parseRequest(const std::string& line, long id);
+
+    /**
+     * @brief Answers a request, measuring its latency.
+     * @param request The request, without error.
+     * @param c The consult used to search the flights.
+     * @return The answer.
+     */
+    static Result answer(const Request& request, Consult& c);
+
+    /**
+     * @brief Writes the result of a request.
+     * @param out The output stream.
+     * @param request The request.
+     * @param result The answer, or nullptr if the request has an error.
+     */
+    void writeResult(std::ostream& out, const Request& request, const Result* result) const;
+
+public:
+    /**
+     * @brief Constructor for the BatchMode class.
+     * @param dataGraph The airport graph queried by the requests.
+     * @param airlineRegistry The registry with the airlines of the graph.
+     * @param options The options of the batch.
+     */
+    BatchMode(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry, const BatchOptions& options);
+
+    /**
+     * @brief Answers every request of the input and reports the throughput and latency percentiles to the standard error.
+     * @return The exit status of the program: 0 on success, 1 if the input or output file cannot be opened.
+     */
+    int run();
+
+    /**
+     * @brief Parses the command line arguments of the batch mode.
+     * @param args The arguments (without the program name): --batch <file|-> [--output <file|->] [--format csv|jsonl] [--threads N].
+     * @param options [out] The parsed options.
+     * @return True if the arguments are valid, otherwise false.
+     */
+    static bool parseArguments(const vector<std::string>& args, BatchOptions& options);
+};
+
+#endif //AED_AIRPORTS_BATCHMODE_H
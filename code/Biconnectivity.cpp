@@ -0,0 +1,100 @@
+#include "Biconnectivity.h"
+#include <algorithm>
+
+Biconnectivity::Biconnectivity(const FrozenGraph& graph, SearchContext& context) {
+    int n = graph.getNumVertex();
+
+    // The undirected projection in CSR form, a flight route in each direction making a single link
+    vector<pair<int, int>> links;
+    for (int v = 0; v < n; v++) {
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getTarget(e);
+            if (v != w) {
+                links.emplace_back(v, w);
+                links.emplace_back(w, v);
+            }
+        }
+    }
+    sort(links.begin(), links.end());
+    links.erase(unique(links.begin(), links.end()), links.end());
+    vector<int> offsets(n + 1, 0), neighbors;
+    neighbors.reserve(links.size());
+    for (const auto& link : links) {
+        offsets[link.first + 1]++;
+        neighbors.push_back(link.second);
+    }
+    for (int v = 0; v < n; v++)
+        offsets[v + 1] += offsets[v];
+    vector<pair<int, int>>().swap(links);
+
+    // Each frame of the explicit stack is a vertex being explored and the position of its next neighbor; the
+    // links met are stacked until the component they belong to is complete
+    context.begin(n);
+    vector<pair<int, int>> frames;
+    vector<pair<int, int>> stackedLinks;
+    vector<int> lastComponent(n, -1);
+    int counter = 0;
+    for (int root = 0; root < n; root++) {
+        if (context.isVisited(root) || offsets[root] == offsets[root + 1])
+            continue;
+        context.setVisited(root);
+        context.num(root) = context.low(root) = counter++;
+        context.parent(root) = -1;
+        frames.emplace_back(root, offsets[root]);
+        int rootChildren = 0;
+
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            int& next = frames.back().second;
+            if (next < offsets[v + 1]) {
+                int w = neighbors[next++];
+                if (!context.isVisited(w)) {
+                    context.setVisited(w);
+                    context.num(w) = context.low(w) = counter++;
+                    context.parent(w) = v;
+                    stackedLinks.emplace_back(v, w);
+                    frames.emplace_back(w, offsets[w]);
+                    if (v == root)
+                        rootChildren++;
+                } else if (w != context.parent(v) && context.num(w) < context.num(v)) {
+                    stackedLinks.emplace_back(v, w);
+                    context.low(v) = min(context.low(v), context.num(w));
+                }
+                continue;
+            }
+
+            // 'v' is fully explored: report what separates it from its parent
+            frames.pop_back();
+            int u = context.parent(v);
+            if (u == -1)
+                continue;
+            context.low(u) = min(context.low(u), context.low(v));
+            if (context.low(v) > context.num(u))
+                bridges.emplace_back(min(u, v), max(u, v));
+            if (context.low(v) >= context.num(u)) {
+                if (u != root)
+                    articulationPoints.push_back(u);
+                vector<int> component;
+                pair<int, int> link;
+                do {
+                    link = stackedLinks.back();
+                    stackedLinks.pop_back();
+                    for (int x : {link.first, link.second}) {
+                        if (lastComponent[x] != static_cast<int>(components.size())) {
+                            lastComponent[x] = static_cast<int>(components.size());
+                            component.push_back(x);
+                        }
+                    }
+                } while (link != make_pair(u, v));
+                sort(component.begin(), component.end());
+                components.push_back(move(component));
+            }
+        }
+        if (rootChildren > 1)
+            articulationPoints.push_back(root);
+    }
+
+    sort(articulationPoints.begin(), articulationPoints.end());
+    articulationPoints.erase(unique(articulationPoints.begin(), articulationPoints.end()), articulationPoints.end());
+    sort(bridges.begin(), bridges.end());
+}
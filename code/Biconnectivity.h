@@ -0,0 +1,68 @@
+/**
+ * @file Biconnectivity.h
+ * @brief Header file containing the articulation airports, bridge routes and biconnected components of the network.
+ *
+ * An airport is essential when removing it disconnects airports that were connected, whatever the direction of
+ * the flights between them, so the 'Biconnectivity' class searches the undirected projection of the airport graph:
+ * two airports are linked if a flight route joins them in either direction. Hopcroft and Tarjan's depth-first
+ * search finds, in linear time, the articulation airports, the bridge routes (links whose removal disconnects
+ * the network) and the biconnected components (maximal groups of links that no single airport separates). The
+ * search keeps an explicit stack of the vertices being explored instead of recursing, so a long chain of airports
+ * cannot overflow the call stack, and works on vertex IDs only.
+ */
+
+#ifndef AED_AIRPORTS_BICONNECTIVITY_H
+#define AED_AIRPORTS_BICONNECTIVITY_H
+
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+
+/**
+ * @class Biconnectivity
+ * @brief The articulation airports, bridge routes and biconnected components of the undirected projection.
+ *
+ * The results do not depend on the search context once computed, nor on the direction of the flight routes.
+ */
+class Biconnectivity {
+private:
+    vector<int> articulationPoints;     ///< The vertex IDs of the articulation airports, in increasing order.
+    vector<pair<int, int>> bridges;     ///< The bridge links, as (smaller, greater) vertex IDs, in increasing order.
+    vector<vector<int>> components;     ///< The vertex IDs of each biconnected component, each in increasing order.
+
+public:
+    /**
+     * @brief Constructs empty results.
+     */
+    Biconnectivity() = default;
+
+    /**
+     * @brief Searches the undirected projection of the airport graph.
+     * @param graph The CSR snapshot of the airport graph.
+     * @param context The search context holding the discovery order and low value of each vertex.
+     *
+     * Time Complexity: O(V+E*log(E)) where V stands for vertices and E for edges, the sort building the undirected
+     * projection, and O(V+E) for the search itself.
+     */
+    Biconnectivity(const FrozenGraph& graph, SearchContext& context);
+
+    /**
+     * @brief Retrieves the articulation airports, whose removal disconnects airports that were connected.
+     * @return The vertex IDs, in increasing order.
+     */
+    const vector<int>& getArticulationPoints() const { return articulationPoints; }
+
+    /**
+     * @brief Retrieves the bridge links, whose removal disconnects airports that were connected.
+     * @return The links as (smaller, greater) vertex IDs, in increasing order.
+     */
+    const vector<pair<int, int>>& getBridges() const { return bridges; }
+
+    /**
+     * @brief Retrieves the biconnected components, every link belonging to exactly one of them.
+     * @return The vertex IDs of each component, with at least two airports. An articulation airport belongs to
+     * several components, an airport without links to none.
+     */
+    const vector<vector<int>>& getComponents() const { return components; }
+};
+
+#endif //AED_AIRPORTS_BICONNECTIVITY_H
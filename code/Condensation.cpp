@@ -0,0 +1,85 @@
+#include "Condensation.h"
+#include <algorithm>
+
+Condensation::Condensation(const FrozenGraph& graph) : components(graph.getNumVertex(), -1) {
+    // Tarjan's algorithm with an explicit stack of (vertex, next edge) frames, which completes the sinks first
+    int n = graph.getNumVertex();
+    vector<int> num(n, -1), low(n, 0), members;
+    vector<pair<int, int>> frames;
+    int counter = 0;
+    for (int root = 0; root < n; root++) {
+        if (num[root] != -1)
+            continue;
+        frames.emplace_back(root, graph.edgesBegin(root));
+        num[root] = low[root] = counter++;
+        members.push_back(root);
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            int& e = frames.back().second;
+            if (e < graph.edgesEnd(v)) {
+                int w = graph.getTarget(e++);
+                if (num[w] == -1) {
+                    num[w] = low[w] = counter++;
+                    members.push_back(w);
+                    frames.emplace_back(w, graph.edgesBegin(w));
+                } else if (components[w] == -1) {
+                    low[v] = min(low[v], num[w]);
+                }
+                continue;
+            }
+            frames.pop_back();
+            if (!frames.empty())
+                low[frames.back().first] = min(low[frames.back().first], low[v]);
+            if (low[v] == num[v]) {
+                int size = 0;
+                for (int w = -1; w != v; size++) {
+                    w = members.back();
+                    members.pop_back();
+                    components[w] = static_cast<int>(sizes.size());
+                }
+                sizes.push_back(size);
+            }
+        }
+    }
+
+    // The arcs of the DAG, without duplicates; a flight route inside a component makes it cyclic
+    int numComponents = getNumComponents();
+    cyclic.assign(numComponents, false);
+    vector<pair<int, int>> arcs;
+    for (int v = 0; v < n; v++) {
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int c = components[v], d = components[graph.getTarget(e)];
+            if (c == d)
+                cyclic[c] = true;
+            else
+                arcs.emplace_back(c, d);
+        }
+    }
+    sort(arcs.begin(), arcs.end());
+    arcs.erase(unique(arcs.begin(), arcs.end()), arcs.end());
+    successorOffsets.assign(numComponents + 1, 0);
+    for (const auto& arc : arcs) {
+        successorOffsets[arc.first + 1]++;
+        successors.push_back(arc.second);
+    }
+    for (int c = 0; c < numComponents; c++)
+        successorOffsets[c + 1] += successorOffsets[c];
+
+    // The components reachable from each one, as bitsets merged from the sinks up, successors having smaller numbers
+    size_t words = (numComponents + 63) / 64;
+    vector<uint64_t> reach(words * numComponents, 0);
+    reachable.assign(numComponents, 0);
+    for (int c = 0; c < numComponents; c++) {
+        uint64_t* own = &reach[c * words];
+        own[c / 64] |= 1ULL << (c % 64);
+        for (int i = successorsBegin(c); i < successorsEnd(c); i++) {
+            const uint64_t* other = &reach[getSuccessor(i) * words];
+            for (size_t k = 0; k < words; k++)
+                own[k] |= other[k];
+        }
+        for (size_t k = 0; k < words; k++) {
+            for (uint64_t bits = own[k]; bits != 0; bits &= bits - 1)
+                reachable[c] += sizes[64 * k + __builtin_ctzll(bits)];
+        }
+    }
+}
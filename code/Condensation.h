@@ -0,0 +1,101 @@
+/**
+ * @file Condensation.h
+ * @brief Header file containing the strongly connected components of the airport graph and their condensation.
+ *
+ * Airports that can all fly to each other, directly or not, form a strongly connected component, and reach the
+ * same airports. The 'Condensation' class finds the components with an iterative Tarjan's algorithm, which keeps
+ * an explicit stack of (vertex, next edge) frames instead of recursing, and builds the condensation: the DAG with a
+ * node per component and an arc wherever a flight route leaves one component for another. The number of airports
+ * reachable from every component is computed once over the DAG, so how many airports an airport can reach is
+ * answered without a search.
+ */
+
+#ifndef AED_AIRPORTS_CONDENSATION_H
+#define AED_AIRPORTS_CONDENSATION_H
+
+#include "FrozenGraph.h"
+#include <cstdint>
+
+/**
+ * @class Condensation
+ * @brief The strongly connected components of the CSR snapshot of the airport graph, and the DAG between them.
+ *
+ * Components are numbered in reverse topological order: every arc of the DAG goes to a smaller component number,
+ * so the sinks come first.
+ */
+class Condensation {
+private:
+    vector<int> components;         ///< The component of each vertex.
+    vector<int> sizes;              ///< The number of vertices of each component.
+    vector<bool> cyclic;            ///< True for each component whose airports can fly back to themselves.
+    vector<int> successorOffsets;   ///< The successors of component 'c' are stored in [successorOffsets[c], successorOffsets[c + 1]).
+    vector<int> successors;         ///< The successor components of every component, each range in increasing order.
+    vector<int> reachable;          ///< The number of vertices reachable from each component, including its own.
+
+public:
+    /**
+     * @brief Constructs the condensation of an empty graph.
+     */
+    Condensation() = default;
+
+    /**
+     * @brief Computes the strongly connected components, the condensation DAG and the reachable vertices of every component.
+     * @param graph The CSR snapshot of the airport graph.
+     *
+     * Time Complexity: O(V+E+C*A/64) where V stands for vertices, E for edges, C for components and A for the arcs
+     * of the condensation, the reachable components being merged as bitsets.
+     */
+    explicit Condensation(const FrozenGraph& graph);
+
+    /**
+     * @brief Retrieves the number of strongly connected components.
+     * @return The number of components.
+     */
+    int getNumComponents() const { return static_cast<int>(sizes.size()); }
+
+    /**
+     * @brief Retrieves the component of a vertex.
+     * @param v The vertex ID.
+     * @return The component number.
+     */
+    int getComponent(int v) const { return components[v]; }
+
+    /**
+     * @brief Retrieves the number of vertices of a component.
+     * @param c The component number.
+     * @return The number of vertices.
+     */
+    int getComponentSize(int c) const { return sizes[c]; }
+
+    /**
+     * @brief Retrieves the position of the first successor of a component in the condensation DAG.
+     * @param c The component number.
+     * @return The position of the first successor, to use with getSuccessor().
+     */
+    int successorsBegin(int c) const { return successorOffsets[c]; }
+
+    /**
+     * @brief Retrieves the position past the last successor of a component in the condensation DAG.
+     * @param c The component number.
+     * @return The position past the last successor.
+     */
+    int successorsEnd(int c) const { return successorOffsets[c + 1]; }
+
+    /**
+     * @brief Retrieves a successor in the condensation DAG.
+     * @param i The position of the successor.
+     * @return The component number of the successor, smaller than the one of its predecessor.
+     */
+    int getSuccessor(int i) const { return successors[i]; }
+
+    /**
+     * @brief Counts the vertices reachable from a vertex through at least one edge.
+     * @param v The vertex ID.
+     * @return The number of vertices, counting 'v' itself only if it can come back to itself.
+     *
+     * Time Complexity: O(1).
+     */
+    int countReachable(int v) const { return reachable[components[v]] - (cyclic[components[v]] ? 0 : 1); }
+};
+
+#endif //AED_AIRPORTS_CONDENSATION_H
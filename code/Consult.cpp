@@ -1,6 +1,6 @@
 #include "Consult.h"
 
-Consult::Consult(const Graph<Airport> &dataGraph, const set<Airline> airlines) : consultGraph(dataGraph) , airlinesInfo(airlines) {};
+Consult::Consult(const Graph<Airport> &dataGraph, const AirlineRegistry& airlines, function<const ContractionHierarchy*()> hierarchySource) : consultGraph(dataGraph) , airlineRegistry(airlines), frozenGraph(dataGraph), airlineRouter(frozenGraph), aStarRouter(frozenGraph), paretoRouter(frozenGraph), waypointPlanner(frozenGraph), condensation(frozenGraph), diameterSearch(frozenGraph), hierarchySource(move(hierarchySource)) {};
 
 int Consult::searchNumberOfAirports() {
     return static_cast<int>(consultGraph.getVertexSet().size());
@@ -29,68 +29,42 @@ int Consult::searchNumberOfFlightsToAirport(Vertex<Airport>* airport) {
 }
 
 int Consult::searchNumberOfFlightsOutOfAirportFromDifferentAirlines(Vertex<Airport>* airport) {
-    set<Airline> airlines;
+    AirlineSet airlines(airlineRegistry.size());
 
     for (const auto& flights : airport->getAdj()) {
-        for (const auto& airline : flights.getAirlines()) {
+        for (auto airline : flights.getAirlines()) {
             airlines.insert(airline);
         }
     }
-    return static_cast<int>(airlines.size());
+    return airlines.count();
 }
 
 map<pair<string,string>, int> Consult::searchNumberOfFlightsPerCity() {
     map<pair<string,string>, int> flightsPerCity;
 
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    for (auto v : consultGraph.getVertexSet())
-        if (!v->isVisited())
-            dfsVisitFlightsPerCity(v, flightsPerCity);
+    for (auto v : consultGraph.getVertexSet()) {
+        pair<string, string> cityAndCountry = make_pair(v->getInfo().getCity(), v->getInfo().getCountry());
+        flightsPerCity[cityAndCountry] += v->getFlightsFrom();
+    }
 
     return flightsPerCity;
 }
 
-void Consult::dfsVisitFlightsPerCity(Vertex<Airport> *v, map<pair<string,string>, int> &res) {
-    v->setVisited(true);
-
-    pair<string, string> cityAndCountry = make_pair(v->getInfo().getCity(), v->getInfo().getCountry());
-    res[cityAndCountry] += v->getFlightsFrom();
-
-    for (auto &flight : v->getAdj()) {
-        auto d = flight.getDest();
-        if (!d->isVisited())
-            dfsVisitFlightsPerCity(d, res);
-    }
-}
-
 map<Airline, int> Consult::searchNumberOfFlightsPerAirline() {
     map<Airline, int> flightsPerAirline;
+    vector<int> flightsPerAirlineId(airlineRegistry.size(), 0);
 
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    for (auto v : consultGraph.getVertexSet())
-        if (!v->isVisited())
-            dfsVisitFlightsPerAirline(v, flightsPerAirline);
-
-    return flightsPerAirline;
-}
-
-void Consult::dfsVisitFlightsPerAirline(Vertex<Airport> *v, map<Airline, int> &res) {
-    v->setVisited(true);
-    for (const auto& flight : v->getAdj()) {
-        for (const auto& airline : flight.getAirlines()) {
-            res[airline]++;
+    for (int e = 0; e < frozenGraph.getNumEdges(); e++) {
+        for (auto airline = frozenGraph.airlinesBegin(e); airline != frozenGraph.airlinesEnd(e); airline++) {
+            flightsPerAirlineId[*airline]++;
         }
     }
 
-    for (auto &flight : v->getAdj()) {
-        auto d = flight.getDest();
-        if (!d->isVisited())
-            dfsVisitFlightsPerAirline(d, res);
+    for (int id = 0; id < airlineRegistry.size(); id++) {
+        if (flightsPerAirlineId[id] > 0)
+            flightsPerAirline.emplace(airlineRegistry.getAirline(id), flightsPerAirlineId[id]);
     }
+    return flightsPerAirline;
 }
 
 int Consult::searchNumberOfCountriesFlownToFromAirport(Vertex<Airport>* airport) {
@@ -104,14 +78,7 @@ int Consult::searchNumberOfCountriesFlownToFromAirport(Vertex<Airport>* airport)
 
 int Consult::searchNumberOfCountriesFlownToFromCity(const string &city, const string& country) {
     set<string> countries;
-    vector<Vertex<Airport>*> cityAirports;
-
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    for (auto v : consultGraph.getVertexSet())
-        if (!v->isVisited())
-            dfsVisitCityAirports(city, country, v, cityAirports);
+    vector<Vertex<Airport>*> cityAirports = dfsCityAirports(city, country);
 
     for (const auto& v : cityAirports) {
         for (const auto& flight : v->getAdj()) {
@@ -121,94 +88,100 @@ int Consult::searchNumberOfCountriesFlownToFromCity(const string &city, const st
     return static_cast<int>(countries.size());
 }
 
-void Consult::dfsVisitCityAirports(const string &city, const string& country, Vertex<Airport> *v, vector<Vertex<Airport>*> &res) {
-    v->setVisited(true);
-    if (RemoveSpaces(ToLower(v->getInfo().getCity())) == city && RemoveSpaces(ToLower(v->getInfo().getCountry())) == country) {
-        res.push_back(v);
-    }
-    for (auto &flight : v->getAdj()) {
-        auto d = flight.getDest();
-        if (!d->isVisited())
-            dfsVisitCityAirports(city, country, d, res);
+vector<Vertex<Airport>*> Consult::dfsCityAirports(const string &city, const string& country) const {
+    vector<Vertex<Airport>*> res;
+    SearchContext& context = SearchContext::local();
+    context.begin(frozenGraph.getNumVertex());
+    vector<int>& toVisit = context.queue();
+
+    for (int root = 0; root < frozenGraph.getNumVertex(); root++) {
+        toVisit.push_back(root);
+        while (!toVisit.empty()) {
+            int v = toVisit.back();
+            toVisit.pop_back();
+            if (context.isVisited(v)) continue;
+            context.setVisited(v);
+
+            auto info = frozenGraph.getVertex(v)->getInfo();
+            if (RemoveSpaces(ToLower(info.getCity())) == city && RemoveSpaces(ToLower(info.getCountry())) == country) {
+                res.push_back(frozenGraph.getVertex(v));
+            }
+            // Neighbours are pushed in reverse so that they are visited in adjacency order
+            for (int e = frozenGraph.edgesEnd(v) - 1; e >= frozenGraph.edgesBegin(v); e--) {
+                if (!context.isVisited(frozenGraph.getTarget(e)))
+                    toVisit.push_back(frozenGraph.getTarget(e));
+            }
+        }
     }
+    return res;
 }
 
-void Consult::dfsAvailableDestinations(Vertex<Airport>* v, std::function<void(Vertex<Airport>*)> processDestination) {
-    for (auto& flight : v->getAdj()) {
-        auto d = flight.getDest();
-        if (!d->isVisited()) {
-            d->setVisited(true);
-            processDestination(d);
-            dfsAvailableDestinations(d, processDestination);
+void Consult::dfsAvailableDestinations(int source, const std::function<void(int)>& processDestination) {
+    SearchContext& context = SearchContext::local();
+    context.begin(frozenGraph.getNumVertex());
+    vector<int>& toVisit = context.queue();
+    toVisit.push_back(source);
+
+    while (!toVisit.empty()) {
+        int v = toVisit.back();
+        toVisit.pop_back();
+        for (int e = frozenGraph.edgesBegin(v); e < frozenGraph.edgesEnd(v); e++) {
+            int d = frozenGraph.getTarget(e);
+            if (!context.isVisited(d)) {
+                context.setVisited(d);
+                processDestination(d);
+                toVisit.push_back(d);
+            }
         }
     }
 }
 
 int Consult::searchNumberOfAirportsAvailableForAirport(Vertex<Airport>* airport) {
-    int numberOfAirports = 0;
-
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    auto countAirports = [&numberOfAirports](Vertex<Airport>* v) { numberOfAirports++; };
-
-    dfsAvailableDestinations(airport, countAirports);
-    return numberOfAirports;
+    return condensation.countReachable(airport->getId());
 }
 
 int Consult::searchNumberOfCitiesAvailableForAirport(Vertex<Airport>* airport) {
     set<pair<string, string>> cityAndRespectiveCountry;
 
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    auto insertCityAndCountry = [&cityAndRespectiveCountry](Vertex<Airport>* v) {
-        cityAndRespectiveCountry.insert({v->getInfo().getCity(), v->getInfo().getCountry()}); };
+    auto insertCityAndCountry = [this, &cityAndRespectiveCountry](int v) {
+        auto info = frozenGraph.getVertex(v)->getInfo();
+        cityAndRespectiveCountry.insert({info.getCity(), info.getCountry()}); };
 
-    dfsAvailableDestinations(airport, insertCityAndCountry);
+    dfsAvailableDestinations(airport->getId(), insertCityAndCountry);
     return static_cast<int>(cityAndRespectiveCountry.size());
 }
 
 int Consult::searchNumberOfCountriesAvailableForAirport(Vertex<Airport>* airport) {
     set<string> countries;
 
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
+    auto insertCountries = [this, &countries](int v) { countries.insert(frozenGraph.getVertex(v)->getInfo().getCountry()); };
 
-    auto insertCountries = [&countries](Vertex<Airport>* v) { countries.insert(v->getInfo().getCountry()); };
-
-    dfsAvailableDestinations(airport, insertCountries);
+    dfsAvailableDestinations(airport->getId(), insertCountries);
     return static_cast<int>(countries.size());
 }
 
 int Consult::searchNumberOfReachableDestinationsInXStopsFromAirport(Vertex<Airport>* airport, int layOvers, const function<string(Vertex<Airport>*)>& attributeExtractor) {
-    queue<pair<Vertex<Airport>*, int>> reachableAirports;
+    SearchContext& context = SearchContext::local();
+    context.begin(frozenGraph.getNumVertex());
+    vector<int>& reachableAirports = context.queue();
     set<string> reachableDestinations;
 
-    for (auto v: consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    reachableAirports.emplace(airport, 0);
-    airport->setVisited(true);
-
-    while (!reachableAirports.empty()) {
-        auto pair = reachableAirports.front();
-        reachableAirports.pop();
+    reachableAirports.push_back(airport->getId());
+    context.setVisited(airport->getId());
+    context.distance(airport->getId()) = 0;
 
-        Vertex<Airport>* a = pair.first;
-        int stop = pair.second;
-
-        if (stop <= layOvers) {
-            for (const auto& flight : a->getAdj()) {
-                reachableDestinations.insert(attributeExtractor(flight.getDest()));
-            }
-        }
+    for (size_t next = 0; next < reachableAirports.size(); next++) {
+        int a = reachableAirports[next];
+        if (context.distance(a) > layOvers)
+            break;
 
-        for (auto& flight : a->getAdj()) {
-            auto d = flight.getDest();
-            if (!d->isVisited()) {
-                reachableAirports.emplace(d, stop + 1);
-                d->setVisited(true);
+        for (int e = frozenGraph.edgesBegin(a); e < frozenGraph.edgesEnd(a); e++) {
+            int d = frozenGraph.getTarget(e);
+            reachableDestinations.insert(attributeExtractor(frozenGraph.getVertex(d)));
+            if (!context.isVisited(d)) {
+                context.setVisited(d);
+                context.distance(d) = context.distance(a) + 1;
+                reachableAirports.push_back(d);
             }
         }
     }
@@ -271,148 +244,178 @@ vector<pair<Airport,int>> Consult::topTrafficCapacityAirports() {
 
 unordered_set<string> Consult::searchEssentialAirports() {
     unordered_set<string> essentialAirports;
-    stack<string> s;
-    int index = 0;
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    for (auto v : consultGraph.getVertexSet()) {
-        if (!v->isVisited()) {
-            dfsEssentialAirports(v, s, essentialAirports, index);
-        }
-    }
-
+    Biconnectivity biconnectivity = searchBiconnectivity();
+    for (int v : biconnectivity.getArticulationPoints())
+        essentialAirports.insert(frozenGraph.getVertex(v)->getInfo().getCode());
     return essentialAirports;
 }
 
-void Consult::dfsEssentialAirports(Vertex<Airport> *v, stack<string> &s, unordered_set<string> &res, int &i) {
-    v->setVisited(true);
-    v->setProcessing(true);
-    v->setNum(i);
-    v->setLow(i);
-    i++;
-    s.push(v->getInfo().getCode());
-    int children = 0;
-
-    for (auto& flight : v->getAdj()) {
-        auto d = flight.getDest();
-        if (!d->isVisited()) {
-            children++;
-            dfsEssentialAirports(d, s, res, i);
-            v->setLow(min(v->getLow(), d->getLow()));
-
-            if ((v->getNum() != 0 && d->getLow() >= v->getNum()) || (v->getNum() == 0 && children > 1)) {
-                res.insert(v->getInfo().getCode());
-            }
-        } else if (d->isProcessing()) {
-            v->setLow(min(v->getLow(), d->getNum()));
-        }
-    }
-    v->setProcessing(false);
-    s.pop();
+Biconnectivity Consult::searchBiconnectivity() {
+    return Biconnectivity(frozenGraph, SearchContext::local());
 }
 
-vector<vector<Vertex<Airport>*>> Consult::searchMaxTripAndCorrespondingPairsOfAirports(int& diameterResult) {
-    int diameter = 0;
+vector<vector<Vertex<Airport>*>> Consult::searchMaxTripAndCorrespondingPairsOfAirports(int& diameter, unsigned threads) {
     vector<vector<Vertex<Airport>*>> airportPaths;
+    for (const auto& trip : diameterSearch.longestTrips(diameter, threads)) {
+        vector<Vertex<Airport>*> path;
+        for (int v : trip)
+            path.push_back(frozenGraph.getVertex(v));
+        airportPaths.push_back(path);
+    }
+    return airportPaths;
+}
 
-    for (const auto& airport : consultGraph.getVertexSet()) {
-        unordered_map<Vertex<Airport>*, int> distanceToOtherAirports;
-        unordered_map<Vertex<Airport>*, vector<Vertex<Airport>*>> pathToOtherAirports;
-        for (const auto& v : consultGraph.getVertexSet())
-            v->setVisited(false);
-
-        distanceToOtherAirports[airport] = 0;
-        pathToOtherAirports[airport] = {airport};
-
-        queue<Vertex<Airport>*> q;
-        q.push(airport);
-        airport->setVisited(true);
-
-        while (!q.empty()) {
-            auto a = q.front();
-            q.pop();
-
-            for (const auto& flight : a->getAdj()) {
-                auto d = flight.getDest();
-                if (!d->isVisited()) {
-                    distanceToOtherAirports[d] = distanceToOtherAirports[a] + 1;
-                    pathToOtherAirports[d] = pathToOtherAirports[a];
-                    pathToOtherAirports[d].emplace_back(d);
-                    q.push(d);
-                    d->setVisited(true);
-                }
-            }
-        }
+map<int, vector<Vertex<Airport>*>> Consult::searchAirportsByEccentricity(unsigned threads) {
+    map<int, vector<Vertex<Airport>*>> airports;
+    vector<int> eccentricities = diameterSearch.eccentricities(threads);
+    for (int v = 0; v < frozenGraph.getNumVertex(); v++)
+        airports[eccentricities[v]].push_back(frozenGraph.getVertex(v));
+    return airports;
+}
 
-        auto distanceASC = [](const auto &p1, const auto &p2) { return p1.second < p2.second; };
-        int maxDistance = max_element(distanceToOtherAirports.begin(), distanceToOtherAirports.end(), distanceASC)->second;
+vector<int> Consult::toIds(const vector<Vertex<Airport>*>& airports) {
+    vector<int> ids;
+    ids.reserve(airports.size());
+    for (auto airport : airports)
+        ids.push_back(airport->getId());
+    return ids;
+}
 
-        if (maxDistance > diameter) {
-            diameter = maxDistance;
-            airportPaths.clear();
-        }
+ShortestPathDag Consult::searchSmallestPathDag(Vertex<Airport>* source, Vertex<Airport>* target) {
+    return ShortestPathDag(frozenGraph, source->getId(), target->getId(), SearchContext::local());
+}
 
-        if (maxDistance == diameter) {
-            for (const auto& pair : distanceToOtherAirports) {
-                if (pair.second == maxDistance) {
-                    airportPaths.emplace_back(pathToOtherAirports[pair.first]);
-                }
-            }
-        }
-    }
-    diameterResult = diameter;
-    return airportPaths;
+ShortestPathDag Consult::searchSmallestPathDag(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets) {
+    return ShortestPathDag(frozenGraph, toIds(sources), toIds(targets), SearchContext::local());
 }
 
 vector<vector<Vertex<Airport>*>> Consult::searchSmallestPathBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target) {
-    vector<vector<Vertex<Airport>*>> smallestPaths;
-
-    for (auto& v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    queue<pair<vector<Vertex<Airport>*>, Vertex<Airport>*>> q;
-    q.push({{source}, source});
-    source->setVisited(true);
-
-    int smallestSize = numeric_limits<int>::max();
-
-    while (!q.empty()) {
-        auto current = q.front();
-        q.pop();
-
-        for (auto& flight : current.second->getAdj()) {
-            auto neighbor = flight.getDest();
-            if (neighbor == target) {
-                current.first.emplace_back(neighbor);
-
-                if (current.first.size() < smallestSize) {
-                    smallestPaths.clear();
-                    smallestPaths.push_back(current.first);
-                    smallestSize = current.first.size();
-                } else if (current.first.size() == smallestSize) {
-                    smallestPaths.push_back(current.first);
-                }
-            } else {
-                if (!neighbor->isVisited()) {
-                    neighbor->setVisited(true);
-                    vector<Vertex<Airport>*> newPath = current.first;
-                    newPath.emplace_back(neighbor);
-                    q.emplace(newPath, neighbor);
-                }
-            }
-        }
+    ShortestPathDag dag = searchSmallestPathDag(source, target);
+    return vector<vector<Vertex<Airport>*>>(dag.begin(), dag.end());
+}
+
+WaypointPaths Consult::searchWaypointPaths(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                           const vector<Vertex<Airport>*>& layovers) {
+    return WaypointPaths(frozenGraph, toIds(sources), toIds(targets), toIds(layovers), SearchContext::local());
+}
+
+Route Consult::searchBestRoute(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                               RouteObjective objective, bool useHeuristic) {
+    return aStarRouter.search(toIds(sources), toIds(targets), objective, useHeuristic, SearchContext::local());
+}
+
+Route Consult::searchShortestRoute(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets) {
+    if (hierarchySource) {
+        hierarchy = hierarchySource();
+        hierarchySource = nullptr;
+    }
+    // The hierarchy does not search round trips, which only an airport that is both a source and a target needs
+    bool roundTrip = any_of(sources.begin(), sources.end(), [&](Vertex<Airport>* source) {
+        return find(targets.begin(), targets.end(), source) != targets.end();
+    });
+    if (hierarchy == nullptr || hierarchy->getNumVertex() != frozenGraph.getNumVertex() || roundTrip)
+        return searchBestRoute(sources, targets, RouteObjective::DISTANCE);
+    return hierarchy->search(frozenGraph, toIds(sources), toIds(targets), SearchContext::local());
+}
+
+vector<Trip> Consult::chainLegs(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination, const vector<Vertex<Airport>*>& layovers,
+                                const function<Route(const vector<Vertex<Airport>*>&, const vector<Vertex<Airport>*>&)>& searchLeg) {
+    vector<Vertex<Airport>*> path;
+    double distance = 0.0;
+    for (size_t i = 0; i <= layovers.size(); ++i) {
+        Route leg = searchLeg(i == 0 ? source : vector<Vertex<Airport>*>{layovers[i - 1]},
+                              i == layovers.size() ? destination : vector<Vertex<Airport>*>{layovers[i]});
+        if (leg.airports.empty())
+            return {};
+        path = path.empty() ? move(leg.airports) : mergeVectors(path, leg.airports);
+        distance += leg.distance;
     }
-    return smallestPaths;
+    return { { set<Airline>(), { move(path), distance } } };
 }
 
-Vertex<Airport>* Consult::findAirportByCode(const string& airportCode) {
-    for (auto airport : consultGraph.getVertexSet()) {
-        if (ToLower(airport->getInfo().getCode()) == ToLower(airportCode)) {
-            return airport;
+vector<Trip> Consult::getShortestDistancePaths(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                               const vector<Vertex<Airport>*>& layovers) {
+    // The legs are independent, so the shortest trip chains the shortest route of each leg
+    return chainLegs(source, destination, layovers, [this](const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets) {
+        return searchShortestRoute(sources, targets);
+    });
+}
+
+KShortestPaths Consult::enumerateBestRoutes(Vertex<Airport>* source, Vertex<Airport>* target, RouteObjective objective) {
+    return KShortestPaths(frozenGraph, source->getId(), target->getId(), objective, SearchContext::local());
+}
+
+vector<ParetoItinerary> Consult::searchParetoItineraries(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                                         const vector<Vertex<Airport>*>& layovers, int maxLabels) {
+    return paretoRouter.search(toIds(sources), toIds(targets), toIds(layovers), maxLabels, SearchContext::local());
+}
+
+WaypointPlan Consult::planLayovers(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                   const vector<Vertex<Airport>*>& layovers, RouteObjective objective) {
+    return waypointPlanner.plan(toIds(sources), toIds(targets), toIds(layovers), objective, SearchContext::local());
+}
+
+vector<AirlinePath> Consult::searchItineraries(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                               const AirlineConstraints& constraints, const vector<Vertex<Airport>*>& layovers) {
+    return airlineRouter.search(toIds(sources), toIds(targets), toIds(layovers), constraints, SearchContext::local());
+}
+
+vector<Trip> Consult::getBestPathsWithAirlineConstraints(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                                         const AirlineConstraints& constraints, const vector<Vertex<Airport>*>& layovers) {
+    vector<Trip> totalPaths;
+    for (auto& path : searchItineraries(source, destination, constraints, layovers)) {
+        double distance = 0.0;
+        for (auto it = path.airports.begin(); it != path.airports.end() - 1; ++it)
+            distance += getDistanceBetweenAirports(*it, *(it + 1));
+        AirlineSet airlines(airlineRegistry.size());
+        for (const auto& flightAirlines : path.airlines) {
+            for (auto airline : flightAirlines)
+                airlines.insert(airline);
         }
+        totalPaths.push_back({ airlineRegistry.toAirlines(airlines.toIds()), { move(path.airports), distance } });
     }
-    return nullptr;
+    return totalPaths;
+}
+
+vector<Trip> Consult::getBestPathsSameAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination, const vector<Vertex<Airport>*>& layovers) {
+    return getBestPathsWithAirlineConstraints(source, destination, AirlineConstraints(), layovers);
+}
+
+vector<Trip> Consult::getBestPathsAllAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination, const vector<Vertex<Airport>*>& layovers) {
+    uint64_t numTrips;
+    return getBestPathsAllAirlines(source, destination, layovers, numeric_limits<size_t>::max(), numTrips);
+}
+
+vector<Trip> Consult::getBestPathsAllAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                              const vector<Vertex<Airport>*>& layovers, size_t maxTrips, uint64_t& numTrips) {
+    // A single search from every source airport to every destination airport only keeps the paths with the fewest layovers,
+    // which are built one at a time until the list is full
+    vector<Trip> totalPaths;
+    WaypointPaths paths = searchWaypointPaths(source, destination, layovers);
+    numTrips = paths.countPaths();
+    bool capped = numTrips > maxTrips;
+    if (capped && maxTrips > 0)
+        totalPaths = getShortestBestPathAllAirlines(source, destination, layovers);
+    for (auto it = paths.begin(); it != paths.end() && totalPaths.size() < maxTrips; ++it) {
+        if (capped && *it == totalPaths[0].second.first)
+            continue;
+        double distance = 0.0;
+        for (auto airport = it->begin(); airport != it->end() - 1; ++airport)
+            distance += getDistanceBetweenAirports(*airport, *(airport + 1));
+        totalPaths.push_back({ set<Airline>(), { *it, distance } });
+    }
+    return totalPaths;
+}
+
+vector<Trip> Consult::getShortestBestPathAllAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                                     const vector<Vertex<Airport>*>& layovers) {
+    return chainLegs(source, destination, layovers, [this](const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets) {
+        return searchBestRoute(sources, targets, RouteObjective::FLIGHTS);
+    });
+}
+
+Vertex<Airport>* Consult::findAirportByCode(const string& airportCode) const {
+    return consultGraph.findVertexByKey(ToUpper(airportCode));
 }
 
 template <typename T>
@@ -470,48 +473,29 @@ vector<Vertex<Airport>*> Consult::findClosestAirports(const Coordinates& coordin
     return closestAirports;
 }
 
-vector<Vertex<Airport>*> Consult::getAirportsInACityAndCountry(const string& city, const string& country) {
-    vector<Vertex<Airport>*> cityAirports;
-
-    for (auto v : consultGraph.getVertexSet())
-        v->setVisited(false);
-
-    for (auto v : consultGraph.getVertexSet())
-        if (!v->isVisited())
-            dfsVisitCityAirports(RemoveSpaces(ToLower(city)), RemoveSpaces(ToLower(country)), v, cityAirports);
-
-    return cityAirports;
+vector<Vertex<Airport>*> Consult::getAirportsInACityAndCountry(const string& city, const string& country) const {
+    return dfsCityAirports(RemoveSpaces(ToLower(city)), RemoveSpaces(ToLower(country)));
 }
 
 set<Airline> Consult::airlinesThatOperateBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target) {
-    set<Airline> airlines;
-    for (auto v : source->getAdj()) {
-        if (v.getDest()->getInfo() == target->getInfo()) {
-            airlines = v.getAirlines();
-            break;
-        }
-    }
-    return airlines;
+    return airlineRegistry.toAirlines(airlineIdsBetweenAirports(source, target));
+}
+
+const vector<AirlineId>& Consult::airlineIdsBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target) {
+    static const vector<AirlineId> noAirlines;
+    const Edge<Airport>* flight = consultGraph.findEdge(source, target);
+    return flight != nullptr ? flight->getAirlines() : noAirlines;
 }
 
 double Consult::getDistanceBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target) {
-    double distance = 0;
-    for (auto v : source->getAdj()) {
-        if (v.getDest()->getInfo() == target->getInfo()) {
-            distance = v.getDistance();
-            break;
-        }
-    }
-    return distance;
+    const Edge<Airport>* flight = consultGraph.findEdge(source, target);
+    return flight != nullptr ? flight->getDistance() : 0;
 }
 
 bool Consult::getAirlineFromCode(Airline& airline, string code) {
-    Airline airlineToFind = Airline();
-    airlineToFind.setCode(ToUpper(code));
-
-    set<Airline>::iterator it = airlinesInfo.find(airlineToFind);
-    if (it != airlinesInfo.end()) {
-        airline = *it;
+    AirlineId id;
+    if (airlineRegistry.findAirlineId(ToUpper(code), id)) {
+        airline = airlineRegistry.getAirline(id);
         return true;
     }
     return false;
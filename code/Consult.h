@@ -13,11 +13,30 @@
 #define AED_AIRPORTS_CONSULT_H
 
 #include "ParseData.h"
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+#include "ShortestPathDag.h"
+#include "AirlineRouter.h"
+#include "AStarRouter.h"
+#include "ParetoRouter.h"
+#include "KShortestPaths.h"
+#include "WaypointPaths.h"
+#include "WaypointPlanner.h"
+#include "ContractionHierarchy.h"
+#include "Condensation.h"
+#include "DiameterSearch.h"
+#include "Biconnectivity.h"
 #include <map>
 #include <unordered_set>
 #include <limits>
 #include <functional>
 
+/**
+ * @brief A flight option: the airlines operating every leg (empty when each leg may use any airline),
+ * the airports of the path and its total distance in kilometers.
+ */
+typedef pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>> Trip;
+
 /**
  * @class Consult
  * @brief Provides functionalities to perform various queries and analyses on Air Travel Flight data.
@@ -26,37 +45,40 @@ class Consult {
 private:
     const Graph<Airport>& consultGraph;     ///< Reference to the airport graph used for consultation.
 
-    const std::set<Airline> airlinesInfo;   ///< Reference to the airlines information set for consultation.
+    const AirlineRegistry& airlineRegistry; ///< Reference to the airlines registry used for consultation.
 
-    /**
-     * @brief Performs a depth-first search to count flights per city of a country from a given vertex.
-     * @param v Pointer to the vertex initiating the search.
-     * @param res Map containing the count of flights per city of a country.
-     */
-    void dfsVisitFlightsPerCity(Vertex<Airport> *v, map<pair<string,string>, int> &res);
+    const FrozenGraph frozenGraph;          ///< Read-only CSR snapshot of the airport graph used by the traversals.
 
-    /**
-     * @brief Performs a depth-first search to count flights per airline from a given vertex.
-     * @param v Pointer to the vertex initiating the search.
-     * @param res Map containing the count of flights per airline.
-     */
-    void dfsVisitFlightsPerAirline(Vertex<Airport> *v, map<Airline, int> &res);
+    const AirlineRouter airlineRouter;      ///< Airline-constrained search over the CSR snapshot.
+
+    const AStarRouter aStarRouter;          ///< Cost-optimal route search over the CSR snapshot.
+
+    const ParetoRouter paretoRouter;        ///< Multi-criteria itinerary search over the CSR snapshot.
+
+    const WaypointPlanner waypointPlanner;  ///< Search of the best order to visit custom layovers.
+
+    const Condensation condensation;        ///< Strongly connected components and the number of airports each one reaches.
+
+    const DiameterSearch diameterSearch;    ///< Eccentricity and diameter searches.
+
+    function<const ContractionHierarchy*()> hierarchySource;   ///< Provides the contraction hierarchy on the first shortest distance search, empty once it did.
+
+    const ContractionHierarchy* hierarchy = nullptr;           ///< Contraction hierarchy of the distances, nullptr if there is none (yet).
 
     /**
      * @brief Initiates a depth-first search to find airports in a specific city and country.
-     * @param city The city to search for.
-     * @param country The country to search for.
-     * @param v Pointer to the vertex initiating the search.
-     * @param res Vector containing vertices representing airports in the given city and country.
+     * @param city The city to search for (lowercase, without spaces).
+     * @param country The country to search for (lowercase, without spaces).
+     * @return Vector with the airports in the given city and country, in depth-first search order.
      */
-    void dfsVisitCityAirports(const string& city, const string& country, Vertex<Airport> *v, vector<Vertex<Airport>*>& res);
+    vector<Vertex<Airport>*> dfsCityAirports(const string& city, const string& country) const;
 
     /**
      * @brief Initiates a depth-first search to process available destinations from a vertex.
-     * @param v Pointer to the vertex initiating the search.
-     * @param processDestination Function to process the available destinations.
+     * @param source ID of the vertex initiating the search.
+     * @param processDestination Function to process the ID of each available destination.
      */
-    void dfsAvailableDestinations(Vertex<Airport>* v, std::function<void(Vertex<Airport>*)> processDestination);
+    void dfsAvailableDestinations(int source, const std::function<void(int)>& processDestination);
 
     /**
      * @brief Searches for the number of reachable destinations from an airport in a specified number of stops.
@@ -73,15 +95,6 @@ private:
      */
     vector<pair<Airport,int>> topTrafficCapacityAirports();
 
-    /**
-     * @brief Initiates a depth-first search to identify essential airports.
-     * @param v Pointer to the vertex initiating the search.
-     * @param s Stack used in the search process.
-     * @param res Unordered set containing essential airports found.
-     * @param i Counter used in the search process.
-     */
-    void dfsEssentialAirports(Vertex<Airport> *v, stack<string> &s, unordered_set<string> &res, int &i);
-
     /**
      * @brief Finds airports based on a specified attribute.
      * @tparam T The type of attribute to search for (name, city, country).
@@ -92,13 +105,36 @@ private:
     template <typename T>
     vector<Vertex<Airport>*> findAirportsByAttribute(const string& searchName, T (Airport::*getAttr)() const);
 
+    /**
+     * @brief Converts airports to their vertex IDs, as used by the searches over the CSR snapshot.
+     * @param airports Vector of airport vertices.
+     * @return Vector with the ID of each airport, in the same order.
+     */
+    static vector<int> toIds(const vector<Vertex<Airport>*>& airports);
+
+    /**
+     * @brief Chains the route of each leg of a trip, the legs being independent of each other.
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @param searchLeg Function to search the route of a leg from its starting airports to its destination airports.
+     * @return The trip, with an empty set of airlines, its path and its total distance (no trip if a leg has no route).
+     */
+    vector<Trip> chainLegs(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination, const vector<Vertex<Airport>*>& layovers,
+                           const function<Route(const vector<Vertex<Airport>*>&, const vector<Vertex<Airport>*>&)>& searchLeg);
+
 public:
+    static const size_t MAX_LISTED_TRIPS = 100;    ///< The most trips listed by the menus when many share the fewest layovers.
+
     /**
      * @brief Constructor for Consult class.
      * @param dataGraph Reference to the airport graph used for consultation.
-     * @param airlinesInfo Reference to the airlines information graph used for consultation.
+     * @param airlineRegistry Reference to the airlines registry used for consultation.
+     * @param hierarchySource Function returning the contraction hierarchy of the graph, which must outlive the consult
+     * (nullptr for none). It is only called by the first shortest distance search, so the hierarchy can be built then.
      */
-    Consult(const Graph<Airport>& dataGraph, const std::set<Airline> airlinesInfo);
+    Consult(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry,
+            function<const ContractionHierarchy*()> hierarchySource = nullptr);
 
     /**
      * @brief Counts the total number of airports.
@@ -156,8 +192,7 @@ public:
      * @brief Searches the number of flights per city of a country.
      * @return Map containing the count of flights per city of a country.
      *
-     * Time Complexity: O(V+E) where V stands for the airport vertices of the graph and E the flight route edges.
-     *             Note: Considering the auxiliary function 'dfsVisitFlightsPerCity'.
+     * Time Complexity: O(V*log(C)) where V stands for the airport vertices of the graph and C for the cities.
      */
     map<pair<string,string>, int> searchNumberOfFlightsPerCity();
 
@@ -165,8 +200,7 @@ public:
      * @brief Searches the number of flights per airline.
      * @return Map containing the count of flights per airline.
      *
-     * Time Complexity: O(V+E+V*A) where V stands for the vertices, E for the edges and A for the airlines.
-     *             Note: Considering the auxiliary function 'dfsVisitFlightsPerAirline'.
+     * Time Complexity: O(V+E*A+A*logA) where V stands for the vertices, E for the edges and A for the airlines.
      */
     map<Airline, int> searchNumberOfFlightsPerAirline();
 
@@ -186,7 +220,7 @@ public:
      * @return The number of countries flown to from the specified city and country.
      *
      * Time Complexity: O(V+E+E') where V stands for vertices, E for edges and E' for the edges going out from the airports in the specified city.
-     *             Note: Considering the auxiliary function 'dfsVisitCityAirports'.
+     *             Note: Considering the auxiliary function 'dfsCityAirports'.
      */
     int searchNumberOfCountriesFlownToFromCity(const string& city, const string& country);
 
@@ -195,8 +229,7 @@ public:
      * @param airport Pointer to the airport vertex.
      * @return The number of available airports reachable from the specified airport.
      *
-     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
-     *             Note: Considering the auxiliary function 'dfsAvailableDestinations'.
+     * Time Complexity: O(1), precomputed per strongly connected component by the class 'Condensation'.
      */
     int searchNumberOfAirportsAvailableForAirport(Vertex<Airport>* airport);
 
@@ -266,43 +299,281 @@ public:
     vector<pair<Airport,int>> searchTopKAirportGreatestAirTrafficCapacity(const int& k);
 
     /**
-     * @brief Searches for essential airports using Tarjan's algorithm for finding strongly connected components.
+     * @brief Searches for essential airports, the articulation points of the network ignoring flight directions.
      * @return An unordered set containing the codes of essential airports.
      *
-     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
-     *             Note: Considering the auxiliary function 'dfsEssentialAirports'.
+     * Time Complexity: O(V+E*log(E)) where V stands for vertices and E for edges.
+     *             Note: Considering the class 'Biconnectivity'.
      */
     unordered_set<string> searchEssentialAirports();
 
+    /**
+     * @brief Searches the articulation airports, bridge routes and biconnected components of the network, ignoring flight directions.
+     * @return The results, as vertex IDs.
+     *
+     * Time Complexity: O(V+E*log(E)) where V stands for vertices and E for edges.
+     */
+    Biconnectivity searchBiconnectivity();
+
+    /**
+     * @brief Retrieves the airport of a vertex ID returned by a search.
+     * @param id The vertex ID.
+     * @return Pointer to the vertex of the airport.
+     */
+    Vertex<Airport>* getAirport(int id) const { return frozenGraph.getVertex(id); }
+
     /**
      * @brief Searches for the maximum trip and corresponding pairs of airports.
      * @details Finds the longest trip possible within the airport network and retrieves all corresponding paths.
+     * @param diameter Receives the number of flights of the longest trip(s).
+     * @param threads The number of worker threads running the searches (0 uses every hardware thread).
      * @return A vector of vectors containing sequences of airports representing the paths of the longest trip(s).
      *
-     * Time Complexity: O(V*(V+E)) where V stands for vertices and E for edges, it needs to iterate over all vertices,
-     *             and for each vertex, it performs BFS.
+     * Time Complexity: O(V*D*(V+E)/(B*T)+S*(V+E)) where V stands for vertices, D for the diameter, E for edges, B for the
+     *             sources searched together, T for threads and S for the sources of the longest trips.
+     */
+    vector<vector<Vertex<Airport>*>> searchMaxTripAndCorrespondingPairsOfAirports(int& diameter, unsigned threads = 0);
+
+    /**
+     * @brief Groups the airports by eccentricity, the greatest number of flights needed to reach an airport from them.
+     * @param threads The number of worker threads running the searches (0 uses every hardware thread).
+     * @return A map from each eccentricity to its airports. Airports without departing flights have eccentricity 0.
+     *
+     * Time Complexity: O(V*D*(V+E)/(B*T)) where V stands for vertices, D for the diameter, E for edges, B for the
+     *             sources searched together and T for threads.
+     */
+    map<int, vector<Vertex<Airport>*>> searchAirportsByEccentricity(unsigned threads = 0);
+
+    /**
+     * @brief Searches for the smallest paths between two airports, without enumerating them.
+     * @param source The starting airport.
+     * @param target The destination airport.
+     * @return The DAG of every path with the fewest flights, whose paths are enumerated lazily by iterating it.
+     *
+     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
      */
-    vector<vector<Vertex<Airport>*>> searchMaxTripAndCorrespondingPairsOfAirports(int& diameter);
+    ShortestPathDag searchSmallestPathDag(Vertex<Airport>* source, Vertex<Airport>* target);
+
+    /**
+     * @brief Searches for the smallest paths from any of the source airports to any of the target airports, in a single search.
+     * @param sources The starting airports (e.g. the airports of a city).
+     * @param targets The destination airports.
+     * @return The DAG of every path with the fewest flights among all pairs of airports. The first and last airports
+     * of each path tell the pair it connects.
+     *
+     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
+     */
+    ShortestPathDag searchSmallestPathDag(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets);
+
+    /**
+     * @brief Searches for the smallest paths from any source airport to any target airport, going through custom
+     * layovers in order, without enumerating them.
+     * @param sources The starting airports.
+     * @param targets The destination airports.
+     * @param layovers The airports the paths must go through, in order (may be empty).
+     * @return The smallest paths of each leg, whose combinations are counted and enumerated lazily. The first leg
+     * starts at the sources closest to the first layover and the last leg ends at the targets closest to the last one.
+     *
+     * Time Complexity: O((L+1)*(V+E)) where L stands for the layovers, V for vertices and E for edges.
+     */
+    WaypointPaths searchWaypointPaths(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                      const vector<Vertex<Airport>*>& layovers);
 
     /**
      * @brief Searches for the smallest path between two airports.
-     * @details Retrieves the smallest path between the specified source and target airports.
+     * @details Retrieves every path with the fewest flights between the specified source and target airports.
      * @param source The starting airport.
      * @param target The destination airport.
      * @return A vector of vectors containing sequences of airports representing the smallest path(s) between the source and target airports.
      *
-     * Time Complexity: O(V*(V+E)) where V stands for vertices and E for edges.
+     * Time Complexity: O(V+E+P*L) where V stands for vertices, E for edges, P for the number of smallest paths and L for their length.
      */
     vector<vector<Vertex<Airport>*>> searchSmallestPathBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target);
 
+    /**
+     * @brief Searches the best route from any of the source airports to any of the target airports.
+     * @param sources The starting airports.
+     * @param targets The destination airports.
+     * @param objective The minimized cost: the number of flights or the flown distance.
+     * @param useHeuristic True for an A* search guided by the great-circle distance, false for Dijkstra's algorithm.
+     * @return The best route (a single one when several are equally good) and the number of airports settled to find it.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges.
+     */
+    Route searchBestRoute(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                          RouteObjective objective, bool useHeuristic = true);
+
+    /**
+     * @brief Searches the route with the shortest distance from any source airport to any target airport.
+     * @param sources The starting airports.
+     * @param targets The destination airports.
+     * @return The shortest route, with no airport if no target is reachable. It goes through the contraction
+     * hierarchy if there is one and no source is a target, otherwise through an A* search. The first call asks the
+     * hierarchy source for the hierarchy, so it must not run concurrently with another call when there is a source.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges, a few dozen airports settled with the hierarchy.
+     */
+    Route searchShortestRoute(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets);
+
+    /**
+     * @brief Finds the flight path with the shortest distance from source to destination.
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @return The shortest trip, with an empty set of airlines, its path and its total distance (no trip if there is none).
+     *
+     * Time Complexity: O((L+1)*(V+E)*log(V)) where L stands for the layovers, V for vertices and E for edges.
+     */
+    vector<Trip> getShortestDistancePaths(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                          const vector<Vertex<Airport>*>& layovers = {});
+
+    /**
+     * @brief Starts the enumeration of the loopless routes between two airports, from the best one.
+     * @param source The starting airport.
+     * @param target The destination airport.
+     * @param objective The minimized cost: the number of flights or the flown distance.
+     * @return The enumeration, whose KShortestPaths::next produces one route at a time. It refers to the snapshot
+     * of this object, so it must not outlive it.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges.
+     */
+    KShortestPaths enumerateBestRoutes(Vertex<Airport>* source, Vertex<Airport>* target, RouteObjective objective);
+
+    /**
+     * @brief Searches the itineraries that no other itinerary beats on flights, distance and airline changes at once.
+     * @param sources The starting airports.
+     * @param targets The destination airports.
+     * @param layovers The airports the itineraries must go through, in order (empty for none).
+     * @param maxLabels The maximum number of partial itineraries kept per airport.
+     * @return The Pareto front, sorted by flights, then distance, then airline changes, with the airline of each flight.
+     *
+     * Time Complexity: see ParetoRouter::search.
+     */
+    vector<ParetoItinerary> searchParetoItineraries(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                                    const vector<Vertex<Airport>*>& layovers = {},
+                                                    int maxLabels = ParetoRouter::DEFAULT_MAX_LABELS);
+
+    /**
+     * @brief Searches the order to visit custom layovers with the fewest flights or the shortest distance.
+     * @param sources The starting airports.
+     * @param targets The destination airports.
+     * @param layovers The airports the trip must go through, in any order.
+     * @param objective The minimized cost.
+     * @return The best order found, as positions in the layovers, with the flights and distance of the trip.
+     *
+     * Time Complexity: see WaypointPlanner::plan.
+     */
+    WaypointPlan planLayovers(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                              const vector<Vertex<Airport>*>& layovers, RouteObjective objective);
+
+    /**
+     * @brief Searches the itineraries with the fewest flights that satisfy airline constraints.
+     * @param sources The starting airports.
+     * @param targets The destination airports.
+     * @param constraints The allowed and denied airlines and the maximum number of airline changes.
+     * @param layovers The airports the itineraries must go through, in order (empty for none).
+     * @return Every airport path with the fewest flights, with the airlines each of its flights can be flown with.
+     *
+     * Time Complexity: see AirlineRouter::search.
+     */
+    vector<AirlinePath> searchItineraries(const vector<Vertex<Airport>*>& sources, const vector<Vertex<Airport>*>& targets,
+                                          const AirlineConstraints& constraints, const vector<Vertex<Airport>*>& layovers = {});
+
+    /**
+     * @brief Finds the best flight paths that satisfy airline constraints from source to destination.
+     *
+     * Searches the flight paths with the fewest layovers between any of the source airports and any of the
+     * destination airports, going through the custom layovers if any, that can be flown with the allowed
+     * airlines and at most the given number of airline changes. A longer path is found when every smaller
+     * one breaks the constraints.
+     *
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param constraints The allowed and denied airlines and the maximum number of airline changes.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @return The best trips, each with the airlines flying any of its legs in some valid itinerary (with no airline
+     * change: the airlines operating all of its legs), its path and its total distance.
+     *
+     * Time Complexity: see AirlineRouter::search.
+     */
+    vector<Trip> getBestPathsWithAirlineConstraints(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                                    const AirlineConstraints& constraints, const vector<Vertex<Airport>*>& layovers = {});
+
+    /**
+     * @brief Finds the best flight paths considering the same airline from source to destination.
+     *
+     * Searches the flight paths with the fewest layovers between any of the source airports and any of the
+     * destination airports, going through the custom layovers if any, such that at least one airline operates
+     * every leg of the journey.
+     *
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @return The best trips, each with the airlines operating all of its legs, its path and its total distance.
+     *
+     * Time Complexity: see AirlineRouter::search, with no airline change.
+     */
+    vector<Trip> getBestPathsSameAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination, const vector<Vertex<Airport>*>& layovers = {});
+
+    /**
+     * @brief Finds the best flight paths considering all available airlines from source to destination.
+     *
+     * Searches the flight paths with the fewest layovers between any of the source airports and any of the
+     * destination airports, going through the custom layovers if any.
+     *
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @return The best trips, each with an empty set of airlines, its path and its total distance.
+     *
+     * Time Complexity: O((L+1)*(V+E)+P*N) where L stands for the layovers, V for vertices, E for edges, P for the number
+     * of best trips and N for their length.
+     */
+    vector<Trip> getBestPathsAllAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination, const vector<Vertex<Airport>*>& layovers = {});
+
+    /**
+     * @brief Finds at most a given number of the best flight paths considering all available airlines from source to destination.
+     *
+     * A few hub layovers can make millions of paths with the fewest layovers, so only the listed ones are built. When
+     * there are more, the list starts with the shortest one, followed by the first ones enumerated.
+     *
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @param maxTrips The most trips listed.
+     * @param numTrips [out] The number of best trips, listed or not (saturated at the maximum value of uint64_t).
+     * @return The listed trips, each with an empty set of airlines, its path and its total distance.
+     *
+     * Time Complexity: O((L+1)*(V+E)*log(V)+M*N) where L stands for the layovers, V for vertices, E for edges, M for the
+     * listed trips and N for their length.
+     */
+    vector<Trip> getBestPathsAllAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                         const vector<Vertex<Airport>*>& layovers, size_t maxTrips, uint64_t& numTrips);
+
+    /**
+     * @brief Finds the shortest of the best flight paths considering all available airlines, without listing the others.
+     *
+     * The legs between the custom layovers are independent, so the shortest best trip chains the route of each leg
+     * with the fewest flights, then the shortest distance.
+     *
+     * @param source A vector of airport vertices representing the source airports.
+     * @param destination A vector of airport vertices representing the destination airports.
+     * @param layovers The airports the flights must go through, in order (empty for none).
+     * @return The shortest best trip, with an empty set of airlines, its path and its total distance (no trip if there is none).
+     *
+     * Time Complexity: O((L+1)*(V+E)*log(V)) where L stands for the layovers, V for vertices and E for edges.
+     */
+    vector<Trip> getShortestBestPathAllAirlines(const vector<Vertex<Airport>*>& source, const vector<Vertex<Airport>*>& destination,
+                                                const vector<Vertex<Airport>*>& layovers = {});
+
     /**
      * @brief Finds an airport vertex based on the airport code.
      * @param airportCode The code of the airport to search for.
      * @return Pointer to the airport vertex if found, nullptr otherwise.
      *
-     * Time Complexity: O(V) where V stands for the airport vertices of the graph.
+     * Time Complexity: O(1) on average, the lookup uses the graph's airport code index.
      */
-    Vertex<Airport>* findAirportByCode(const string& airportCode);
+    Vertex<Airport>* findAirportByCode(const string& airportCode) const;
 
     /**
      * @brief Finds airports based on the airport name.
@@ -350,9 +621,9 @@ public:
      * @return Vector of airport vertices in the specified city and country.
      *
      * Time Complexity: O(V+E) where V stands for vertices and E for edges.
-     *             Note: Considering the auxiliary function 'dfsVisitCityAirports'.
+     *             Note: Considering the auxiliary function 'dfsCityAirports'.
      */
-    vector<Vertex<Airport>*> getAirportsInACityAndCountry(const string& city, const string& country);
+    vector<Vertex<Airport>*> getAirportsInACityAndCountry(const string& city, const string& country) const;
 
     /**
      * @brief Retrieves the set of airlines that operate between two airports.
@@ -360,24 +631,40 @@ public:
      * @param target Pointer to the target airport.
      * @return Set of airlines that operate between the specified airports.
      *
-     * Time Complexity: O(E) where E stands for edges (flight routes).
+     * Time Complexity: O(A*log(A)) where A stands for the number of airlines of the flight route.
      */
     std::set<Airline> airlinesThatOperateBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target);
 
+    /**
+     * @brief Retrieves the IDs of the airlines that operate between two airports, without copying them.
+     * @param source Pointer to the source airport.
+     * @param target Pointer to the target airport.
+     * @return Constant reference to the sorted airline IDs of the flight route (empty if there is no route).
+     *
+     * Time Complexity: O(1) on average, the flight route is found through the edge index of the graph.
+     */
+    const std::vector<AirlineId>& airlineIdsBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target);
+
+    /**
+     * @brief Retrieves the airlines registry used for consultation.
+     * @return Constant reference to the airlines registry.
+     */
+    const AirlineRegistry& getAirlineRegistry() const { return airlineRegistry; }
+
     /**
      * @brief Retrieves the distance between two airports.
      * @param source Pointer to the source airport.
      * @param target Pointer to the target airport.
      * @return The distance between the specified airports in kilometers.
      *
-     * Time Complexity: O(E) where E stands for edges (flight routes).
+     * Time Complexity: O(1) on average, the flight route is found through the edge index of the graph.
      */
     double getDistanceBetweenAirports(Vertex<Airport>* source, Vertex<Airport>* target);
 
     /**
-     * @brief Retrieves an airline from the airlinesInfo set based on the provided code.
+     * @brief Retrieves an airline from the airlines registry based on the provided code.
      *
-     * This function searches for an airline in the airlinesInfo set using a specified code.
+     * This function searches for an airline in the airlines registry using a specified code.
      * If the airline is found, it is returned via the 'airline' parameter.
      *
      * @param airline [out] The reference to an Airline object where the found airline will be stored.
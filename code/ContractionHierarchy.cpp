@@ -0,0 +1,286 @@
+#include "ContractionHierarchy.h"
+#include <limits>
+
+static const double INFINITE_COST = numeric_limits<double>::infinity();
+
+// Adds two (distance, flights) costs
+static pair<double, double> addCosts(const pair<double, double>& a, const pair<double, double>& b) {
+    return {a.first + b.first, a.second + b.second};
+}
+
+static pair<double, double> arcCost(const ContractionHierarchy::Arc& arc) {
+    return {arc.distance, arc.flights};
+}
+
+ContractionHierarchy::ContractionHierarchy(const FrozenGraph& graph, SearchContext& context) {
+    int n = graph.getNumVertex();
+
+    // The remaining graph: the arcs between airports not contracted yet, at most one per pair of airports
+    vector<Arc> work;
+    vector<vector<int>> out(n), in(n);
+    auto addArc = [&](const Arc& arc) {
+        for (int index : out[arc.source]) {
+            if (work[index].target != arc.target)
+                continue;
+            if (arcCost(arc) < arcCost(work[index]))
+                work[index] = arc;
+            return;
+        }
+        out[arc.source].push_back(static_cast<int>(work.size()));
+        in[arc.target].push_back(static_cast<int>(work.size()));
+        work.push_back(arc);
+    };
+    for (int v = 0; v < n; v++) {
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            if (graph.getTarget(e) != v)
+                addArc({v, graph.getTarget(e), -1, 1, graph.getDistance(e)});
+        }
+    }
+
+    // Finds the shortcuts needed to contract an airport: a route through it needs one unless a search from its
+    // first airport that avoids it finds a route at most as costly
+    auto findShortcuts = [&](int v) {
+        vector<Arc> shortcuts;
+        for (int a : in[v]) {
+            int u = work[a].source;
+            pair<double, double> limit = {0, 0};
+            for (int b : out[v])
+                limit = max(limit, addCosts(arcCost(work[a]), arcCost(work[b])));
+
+            context.begin(n);
+            auto& heap = context.heap();
+            int unsettled = 0;
+            for (int b : out[v]) {
+                if (!context.isMarked(work[b].target)) {
+                    context.setMark(work[b].target, 1);
+                    unsettled++;
+                }
+            }
+            context.setVisited(u);
+            context.cost(u) = {0, 0};
+            heap.push(context.cost(u), u);
+            int settled = 0;
+            while (!heap.empty() && settled < WITNESS_SETTLE_LIMIT && unsettled > 0) {
+                int x = heap.top().second;
+                pair<double, double> cost = heap.top().first;
+                heap.pop();
+                if (context.isProcessing(x))
+                    continue;
+                if (limit < cost)
+                    break;
+                context.setProcessing(x, true);
+                settled++;
+                if (context.isMarked(x))
+                    unsettled--;
+                for (int c : out[x]) {
+                    int y = work[c].target;
+                    if (y == v)
+                        continue;
+                    pair<double, double> through = addCosts(cost, arcCost(work[c]));
+                    if (limit < through || (context.isVisited(y) && !(through < context.cost(y))))
+                        continue;
+                    context.setVisited(y);
+                    context.cost(y) = through;
+                    heap.push(through, y);
+                }
+            }
+
+            for (int b : out[v]) {
+                int w = work[b].target;
+                if (w == u)
+                    continue;
+                pair<double, double> via = addCosts(arcCost(work[a]), arcCost(work[b]));
+                if (context.isVisited(w) && !(via < context.cost(w)))
+                    continue;
+                shortcuts.push_back({u, w, v, static_cast<int>(via.second), via.first});
+            }
+        }
+        return shortcuts;
+    };
+
+    // The priority of an airport is the arcs its contraction adds minus the ones it removes, plus its neighbours
+    // already contracted so the contraction spreads evenly over the graph
+    vector<int> contractedNeighbours(n, 0);
+    auto priority = [&](int v, const vector<Arc>& shortcuts) {
+        return static_cast<int>(shortcuts.size() - in[v].size() - out[v].size()) + contractedNeighbours[v];
+    };
+    DaryHeap<int, int> queue;
+    for (int v = 0; v < n; v++)
+        queue.push(priority(v, findShortcuts(v)), v);
+
+    ranks.assign(n, -1);
+    int rank = 0;
+    while (!queue.empty()) {
+        int v = queue.top().second;
+        queue.pop();
+        if (ranks[v] != -1)
+            continue;
+        // The priority may be outdated by the contractions since it was computed
+        vector<Arc> shortcuts = findShortcuts(v);
+        int current = priority(v, shortcuts);
+        if (!queue.empty() && current > queue.top().first) {
+            queue.push(current, v);
+            continue;
+        }
+
+        for (const Arc& arc : shortcuts)
+            addArc(arc);
+        ranks[v] = rank++;
+        vector<int> neighbours;
+        for (int a : out[v]) {
+            arcs.push_back(work[a]);
+            int w = work[a].target;
+            in[w].erase(find(in[w].begin(), in[w].end(), a));
+            neighbours.push_back(w);
+        }
+        for (int a : in[v]) {
+            arcs.push_back(work[a]);
+            int u = work[a].source;
+            out[u].erase(find(out[u].begin(), out[u].end(), a));
+            neighbours.push_back(u);
+        }
+        out[v].clear();
+        in[v].clear();
+        sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (int w : neighbours)
+            contractedNeighbours[w]++;
+    }
+    index();
+}
+
+ContractionHierarchy::ContractionHierarchy(vector<int> ranks, vector<Arc> arcs) : ranks(move(ranks)), arcs(move(arcs)) {
+    index();
+}
+
+void ContractionHierarchy::index() {
+    int n = getNumVertex();
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    for (const Arc& arc : arcs) {
+        if (ranks[arc.target] > ranks[arc.source])
+            upOffsets[arc.source + 1]++;
+        else
+            downOffsets[arc.target + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        upOffsets[v + 1] += upOffsets[v];
+        downOffsets[v + 1] += downOffsets[v];
+    }
+    upArcs.assign(upOffsets[n], 0);
+    downArcs.assign(downOffsets[n], 0);
+    vector<int> upNext(upOffsets.begin(), upOffsets.end() - 1), downNext(downOffsets.begin(), downOffsets.end() - 1);
+    for (int a = 0; a < static_cast<int>(arcs.size()); a++) {
+        if (ranks[arcs[a].target] > ranks[arcs[a].source])
+            upArcs[upNext[arcs[a].source]++] = a;
+        else
+            downArcs[downNext[arcs[a].target]++] = a;
+    }
+}
+
+int ContractionHierarchy::findArc(int source, int target) const {
+    int best = -1;
+    bool up = ranks[target] > ranks[source];
+    int v = up ? source : target;
+    const vector<int>& offsets = up ? upOffsets : downOffsets;
+    const vector<int>& list = up ? upArcs : downArcs;
+    for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+        const Arc& arc = arcs[list[i]];
+        if (arc.source == source && arc.target == target && (best == -1 || arcCost(arc) < arcCost(arcs[best])))
+            best = list[i];
+    }
+    return best;
+}
+
+Route ContractionHierarchy::search(const FrozenGraph& graph, const vector<int>& sources, const vector<int>& targets, SearchContext& context) const {
+    // State v is airport v in the forward search, state n + v is airport v in the backward search
+    int n = getNumVertex();
+    context.begin(2 * n);
+    auto& heap = context.heap();
+    auto seed = [&](int state) {
+        if (context.isVisited(state))
+            return;
+        context.setVisited(state);
+        context.cost(state) = {0, 0};
+        context.parent(state) = -1;
+        heap.push(context.cost(state), state);
+    };
+    for (int source : sources)
+        seed(source);
+    for (int target : targets)
+        seed(n + target);
+
+    Route route;
+    pair<double, double> best = {INFINITE_COST, INFINITE_COST};
+    int meet = -1;
+    while (!heap.empty()) {
+        int state = heap.top().second;
+        pair<double, double> cost = heap.top().first;
+        heap.pop();
+        if (context.isProcessing(state))
+            continue;
+        if (!(cost < best))
+            break;
+        context.setProcessing(state, true);
+        route.settled++;
+
+        bool forward = state < n;
+        int v = forward ? state : state - n;
+        int opposite = forward ? n + v : v;
+        if (context.isVisited(opposite) && addCosts(cost, context.cost(opposite)) < best) {
+            best = addCosts(cost, context.cost(opposite));
+            meet = v;
+        }
+
+        // An airport reached more cheaply from a higher ranked one is not on a shortest route (stall-on-demand)
+        const vector<int>& stallOffsets = forward ? downOffsets : upOffsets;
+        const vector<int>& stallArcs = forward ? downArcs : upArcs;
+        bool stalled = false;
+        for (int i = stallOffsets[v]; i < stallOffsets[v + 1] && !stalled; i++) {
+            const Arc& arc = arcs[stallArcs[i]];
+            int w = forward ? arc.source : n + arc.target;
+            stalled = context.isVisited(w) && addCosts(context.cost(w), arcCost(arc)) < cost;
+        }
+        if (stalled)
+            continue;
+
+        const vector<int>& offsets = forward ? upOffsets : downOffsets;
+        const vector<int>& list = forward ? upArcs : downArcs;
+        for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+            const Arc& arc = arcs[list[i]];
+            int next = forward ? arc.target : n + arc.source;
+            pair<double, double> through = addCosts(cost, arcCost(arc));
+            if (context.isVisited(next) && !(through < context.cost(next)))
+                continue;
+            context.setVisited(next);
+            context.cost(next) = through;
+            context.parent(next) = list[i];
+            heap.push(through, next);
+        }
+    }
+    if (meet == -1)
+        return route;
+
+    // The arcs up to the meeting airport and down from it, then each shortcut replaced by the two arcs it joins
+    vector<int> path;
+    for (int a = context.parent(meet); a != -1; a = context.parent(arcs[a].source))
+        path.push_back(a);
+    reverse(path.begin(), path.end());
+    for (int a = context.parent(n + meet); a != -1; a = context.parent(n + arcs[a].target))
+        path.push_back(a);
+
+    route.airports.push_back(graph.getVertex(path.empty() ? meet : arcs[path[0]].source));
+    vector<int> stack(path.rbegin(), path.rend());
+    while (!stack.empty()) {
+        const Arc& arc = arcs[stack.back()];
+        stack.pop_back();
+        if (arc.middle == -1) {
+            route.airports.push_back(graph.getVertex(arc.target));
+            continue;
+        }
+        stack.push_back(findArc(arc.middle, arc.target));
+        stack.push_back(findArc(arc.source, arc.middle));
+    }
+    route.distance = best.first;
+    return route;
+}
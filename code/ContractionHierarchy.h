@@ -0,0 +1,126 @@
+/**
+ * @file ContractionHierarchy.h
+ * @brief Header file containing the contraction hierarchy of the flight route distances.
+ *
+ * The airport graph never changes once it is loaded, so the shortest distance searches can share a preprocessing
+ * step. The 'ContractionHierarchy' class contracts the airports one at a time, least important first: removing an
+ * airport adds a shortcut between two of its neighbours whenever the route through it was the only shortest one
+ * between them. Every route then climbs to the most important airport on it and climbs down again, so a query
+ * runs a bidirectional search that only follows arcs towards more important airports, and settles a few dozen
+ * airports instead of most of the graph. The hierarchy is built when the binary snapshot is written and is
+ * stored in it (see Snapshot.h).
+ */
+
+#ifndef AED_AIRPORTS_CONTRACTIONHIERARCHY_H
+#define AED_AIRPORTS_CONTRACTIONHIERARCHY_H
+
+#include "AStarRouter.h"
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+
+/**
+ * @class ContractionHierarchy
+ * @brief The airports ranked by importance and the arcs between them, answering shortest distance queries.
+ *
+ * Costs are compared as (distance, flights), like the searches for RouteObjective::DISTANCE.
+ */
+class ContractionHierarchy {
+public:
+    /**
+     * @struct Arc
+     * @brief A flight route or a shortcut of the hierarchy.
+     */
+    struct Arc {
+        int source;         ///< The vertex ID of the first airport.
+        int target;         ///< The vertex ID of the last airport.
+        int middle;         ///< The vertex ID of the airport a shortcut replaces, -1 for a flight route.
+        int flights;        ///< The number of flights the arc stands for.
+        double distance;    ///< The distance of the arc, in kilometers.
+    };
+
+private:
+    vector<int> ranks;          ///< The rank of each vertex in the contraction order, higher for more important airports.
+    vector<Arc> arcs;           ///< The arcs of the hierarchy, each from its lower ranked airport to its higher ranked one or the other way.
+    vector<int> upOffsets;      ///< The arcs leaving each vertex towards a higher rank are upArcs[upOffsets[v], upOffsets[v + 1]).
+    vector<int> upArcs;         ///< The indices of the arcs leaving each vertex towards a higher rank.
+    vector<int> downOffsets;    ///< The arcs entering each vertex from a higher rank are downArcs[downOffsets[v], downOffsets[v + 1]).
+    vector<int> downArcs;       ///< The indices of the arcs entering each vertex from a higher rank.
+
+    /**
+     * @brief Builds the upward and downward arc lists of each vertex.
+     */
+    void index();
+
+    /**
+     * @brief Retrieves the cheapest arc between two airports.
+     * @param source The vertex ID of the first airport.
+     * @param target The vertex ID of the last airport.
+     * @return The index of the arc, which must exist.
+     */
+    int findArc(int source, int target) const;
+
+public:
+    static const int WITNESS_SETTLE_LIMIT = 100;    ///< The airports settled by a search for a route avoiding a contracted airport.
+
+    /**
+     * @brief Constructs an empty hierarchy, which answers no query.
+     */
+    ContractionHierarchy() = default;
+
+    /**
+     * @brief Contracts every airport of the graph.
+     * @param graph The CSR snapshot of the airport graph.
+     * @param context The search context used by the searches for routes avoiding each contracted airport.
+     *
+     * Time Complexity: O(V*D^2*W*log(W)) where V stands for vertices, D for the degree of an airport when it is
+     * contracted and W for WITNESS_SETTLE_LIMIT.
+     */
+    ContractionHierarchy(const FrozenGraph& graph, SearchContext& context);
+
+    /**
+     * @brief Restores a hierarchy from its ranks and arcs, such as the ones stored in a snapshot.
+     * @param ranks The rank of each vertex.
+     * @param arcs The arcs of the hierarchy.
+     *
+     * Time Complexity: O(V+A) where V stands for vertices and A for arcs.
+     */
+    ContractionHierarchy(vector<int> ranks, vector<Arc> arcs);
+
+    /**
+     * @brief Checks if the hierarchy has no airport.
+     * @return True if it is empty, otherwise false.
+     */
+    bool empty() const { return ranks.empty(); }
+
+    /**
+     * @brief Retrieves the number of airports of the hierarchy.
+     * @return The number of vertices.
+     */
+    int getNumVertex() const { return static_cast<int>(ranks.size()); }
+
+    /**
+     * @brief Retrieves the rank of each vertex in the contraction order.
+     * @return The ranks, indexed by vertex ID.
+     */
+    const vector<int>& getRanks() const { return ranks; }
+
+    /**
+     * @brief Retrieves the arcs of the hierarchy, flight routes and shortcuts.
+     * @return The arcs.
+     */
+    const vector<Arc>& getArcs() const { return arcs; }
+
+    /**
+     * @brief Searches the shortest route from any source airport to any target airport.
+     * @param graph The CSR snapshot of the airport graph the hierarchy was built from.
+     * @param sources The vertex IDs of the starting airports.
+     * @param targets The vertex IDs of the destination airports, none of them a source (round trips are not searched).
+     * @param context The search context holding the costs, parents and heap of both directions of the search.
+     * @return The shortest route, with no airport if no target is reachable.
+     *
+     * Time Complexity: O((V+A)*log(V)) where V stands for vertices and A for arcs, in practice a few dozen airports.
+     */
+    Route search(const FrozenGraph& graph, const vector<int>& sources, const vector<int>& targets, SearchContext& context) const;
+};
+
+#endif //AED_AIRPORTS_CONTRACTIONHIERARCHY_H
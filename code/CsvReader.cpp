@@ -0,0 +1,72 @@
+#include "CsvReader.h"
+#include "Utilities.h"
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+MappedFile::MappedFile(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) return;
+
+    struct stat info{};
+    if (fstat(fd, &info) == 0) {
+        size = static_cast<size_t>(info.st_size);
+        if (size == 0) {
+            opened = true;
+        } else {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                madvise(mapping, size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(mapping);
+                opened = true;
+            }
+        }
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+}
+
+void CsvReader::skipLine() {
+    size_t end = text.find('\n', position);
+    position = (end == string_view::npos) ? text.size() : end + 1;
+}
+
+bool CsvReader::nextRow(vector<string_view>& fields) {
+    while (position < text.size()) {
+        size_t end = text.find('\n', position);
+        if (end == string_view::npos) end = text.size();
+        string_view line = text.substr(position, end - position);
+        position = end + 1;
+
+        if (TrimView(line).empty()) continue;
+
+        fields.clear();
+        size_t start = 0;
+        while (true) {
+            size_t comma = line.find(',', start);
+            if (comma == string_view::npos) {
+                fields.push_back(TrimView(line.substr(start)));
+                break;
+            }
+            fields.push_back(TrimView(line.substr(start, comma - start)));
+            start = comma + 1;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ParseDouble(string_view field, double& value) {
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    if (first != last && *first == '+') first++;
+    auto result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file CsvReader.h
+ * @brief Header file containing the zero-copy CSV reading utilities.
+ *
+ * This file defines the 'MappedFile' class, which maps a whole file into memory, and the 'CsvReader' class,
+ * which tokenizes the mapped text in place. Rows are returned as 'std::string_view' fields pointing into the
+ * mapping, so no string is allocated until the caller stores a field in its final structure.
+ */
+
+#ifndef AED_AIRPORTS_CSVREADER_H
+#define AED_AIRPORTS_CSVREADER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a file, unmapped when the object is destroyed.
+ */
+class MappedFile {
+private:
+    const char* data = nullptr;     ///< Beginning of the mapped file content.
+    size_t size = 0;                ///< The size of the file in bytes.
+    bool opened = false;            ///< Indicates if the file was opened and mapped successfully.
+
+public:
+    /**
+     * @brief Constructor for the MappedFile class, maps the whole file into memory.
+     * @param path The path of the file to map.
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Destructor for the MappedFile class, releases the mapping.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Checks if the file was mapped successfully.
+     * @return True if the file content is available, otherwise false.
+     */
+    bool isOpen() const { return opened; }
+
+    /**
+     * @brief Retrieves the content of the file.
+     * @return View over the whole mapped file.
+     */
+    std::string_view view() const { return {data, size}; }
+};
+
+/**
+ * @class CsvReader
+ * @brief Splits CSV text into rows of trimmed fields without copying it.
+ *
+ * Fields are separated by commas and rows by new lines ("\n" or "\r\n"), quoted fields are not supported,
+ * matching the format of the data files. Blank lines are skipped.
+ */
+class CsvReader {
+private:
+    std::string_view text;  ///< The text being tokenized.
+    size_t position = 0;    ///< Offset of the next unread character.
+
+public:
+    /**
+     * @brief Constructor for the CsvReader class.
+     * @param text The CSV text to tokenize, it must outlive the reader.
+     */
+    explicit CsvReader(std::string_view text) : text(text) {}
+
+    /**
+     * @brief Skips the next line, typically the header.
+     */
+    void skipLine();
+
+    /**
+     * @brief Reads the next non-blank row.
+     * @param fields [out] The trimmed fields of the row, as views into the text.
+     * @return True if a row was read, false at the end of the text.
+     */
+    bool nextRow(std::vector<std::string_view>& fields);
+};
+
+/**
+ * @brief Parses a decimal number from a field, without allocating.
+ * @param field The text of the number.
+ * @param value [out] The parsed value.
+ * @return True if the whole field is a valid number, otherwise false.
+ */
+bool ParseDouble(std::string_view field, double& value);
+
+#endif //AED_AIRPORTS_CSVREADER_H
@@ -0,0 +1,111 @@
+/**
+ * @file DaryHeap.h
+ * @brief Header file containing a d-ary min-heap.
+ *
+ * This file defines the 'DaryHeap' class template, the priority queue of the shortest path searches. A heap with
+ * D children per node is shallower than a binary heap, so pushes (the most frequent operation of a search) move
+ * fewer elements, and the children compared by a pop lie next to each other in memory. The heap has no
+ * decrease-key: a search pushes a vertex again when it finds a shorter path and skips the stale entries it pops.
+ */
+
+#ifndef AED_AIRPORTS_DARYHEAP_H
+#define AED_AIRPORTS_DARYHEAP_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class DaryHeap
+ * @brief Min-heap of (key, value) pairs with D children per node.
+ * @tparam Key The type of the keys, ordered by operator<.
+ * @tparam Value The type of the values.
+ * @tparam D The number of children of each node.
+ */
+template <class Key, class Value, int D = 4>
+class DaryHeap {
+private:
+    std::vector<std::pair<Key, Value>> items;   ///< The heap, the children of item 'i' are items D*i+1 to D*i+D.
+
+public:
+    /**
+     * @brief Checks if the heap is empty.
+     * @return True if the heap has no item, otherwise false.
+     */
+    bool empty() const { return items.empty(); }
+
+    /**
+     * @brief Retrieves the number of items.
+     * @return The number of items in the heap.
+     */
+    std::size_t size() const { return items.size(); }
+
+    /**
+     * @brief Removes every item, keeping the allocated memory.
+     */
+    void clear() { items.clear(); }
+
+    /**
+     * @brief Retrieves the item with the smallest key.
+     * @return Constant reference to the item, the heap must not be empty.
+     */
+    const std::pair<Key, Value>& top() const { return items.front(); }
+
+    /**
+     * @brief Inserts an item.
+     * @param key The key of the item.
+     * @param value The value of the item.
+     *
+     * Time Complexity: O(log(n)/log(D)) where n stands for the number of items.
+     */
+    void push(Key key, Value value);
+
+    /**
+     * @brief Removes the item with the smallest key.
+     *
+     * Time Complexity: O(D*log(n)/log(D)) where n stands for the number of items.
+     */
+    void pop();
+};
+
+template <class Key, class Value, int D>
+void DaryHeap<Key, Value, D>::push(Key key, Value value) {
+    std::size_t i = items.size();
+    items.emplace_back();
+    while (i > 0) {
+        std::size_t parent = (i - 1) / D;
+        if (!(key < items[parent].first))
+            break;
+        items[i] = std::move(items[parent]);
+        i = parent;
+    }
+    items[i] = {key, std::move(value)};
+}
+
+template <class Key, class Value, int D>
+void DaryHeap<Key, Value, D>::pop() {
+    std::pair<Key, Value> last = std::move(items.back());
+    items.pop_back();
+    if (items.empty())
+        return;
+
+    std::size_t i = 0;
+    while (true) {
+        std::size_t first = D * i + 1;
+        if (first >= items.size())
+            break;
+        std::size_t smallest = first;
+        std::size_t end = first + D < items.size() ? first + D : items.size();
+        for (std::size_t child = first + 1; child < end; child++) {
+            if (items[child].first < items[smallest].first)
+                smallest = child;
+        }
+        if (!(items[smallest].first < last.first))
+            break;
+        items[i] = std::move(items[smallest]);
+        i = smallest;
+    }
+    items[i] = std::move(last);
+}
+
+#endif //AED_AIRPORTS_DARYHEAP_H
@@ -0,0 +1,134 @@
+#include "DiameterSearch.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+const int DiameterSearch::BATCH_WORDS;
+const int DiameterSearch::BATCH_SOURCES;
+
+DiameterSearch::DiameterSearch(const FrozenGraph& graph) : graph(graph) {}
+
+int DiameterSearch::eccentricity(int source, SearchContext& context) const {
+    context.begin(graph.getNumVertex());
+    vector<int>& order = context.queue();
+    context.setVisited(source);
+    context.distance(source) = 0;
+    context.parent(source) = -1;
+    order.push_back(source);
+
+    for (size_t next = 0; next < order.size(); next++) {
+        int v = order[next];
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getTarget(e);
+            if (!context.isVisited(w)) {
+                context.setVisited(w);
+                context.distance(w) = context.distance(v) + 1;
+                context.parent(w) = v;
+                order.push_back(w);
+            }
+        }
+    }
+    return context.distance(order.back());
+}
+
+void DiameterSearch::searchBatch(int first, vector<uint64_t>& seen, vector<uint64_t>& visit, vector<uint64_t>& next, vector<int>& result) const {
+    int n = graph.getNumVertex();
+    int count = min(BATCH_SOURCES, n - first);
+    fill(seen.begin(), seen.end(), 0);
+    fill(visit.begin(), visit.end(), 0);
+    uint64_t full[BATCH_WORDS];
+    for (int k = 0; k < BATCH_WORDS; k++) {
+        int bits = max(0, min(64, count - 64 * k));
+        full[k] = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+    }
+    for (int bit = 0; bit < count; bit++) {
+        seen[(first + bit) * BATCH_WORDS + bit / 64] |= 1ULL << (bit % 64);
+        visit[(first + bit) * BATCH_WORDS + bit / 64] |= 1ULL << (bit % 64);
+        result[first + bit] = 0;
+    }
+
+    for (int level = 1;; level++) {
+        // Each airport gathers the searches that reached one of its predecessors at the latest level, which writes
+        // only its own bits: no search is lost to another one, and the loops over the words vectorize
+        uint64_t reached[BATCH_WORDS] = {};
+        for (int w = 0; w < n; w++) {
+            uint64_t* wSeen = &seen[w * BATCH_WORDS];
+            uint64_t gathered[BATCH_WORDS] = {};
+            bool complete = true;
+            for (int k = 0; k < BATCH_WORDS; k++)
+                complete &= wSeen[k] == full[k];
+            if (!complete) {
+                for (int i = graph.inEdgesBegin(w); i < graph.inEdgesEnd(w); i++) {
+                    const uint64_t* vVisit = &visit[graph.getSource(i) * BATCH_WORDS];
+                    for (int k = 0; k < BATCH_WORDS; k++)
+                        gathered[k] |= vVisit[k];
+                }
+            }
+            for (int k = 0; k < BATCH_WORDS; k++) {
+                gathered[k] &= ~wSeen[k];
+                next[w * BATCH_WORDS + k] = gathered[k];
+                wSeen[k] |= gathered[k];
+                reached[k] |= gathered[k];
+            }
+        }
+
+        bool done = true;
+        for (int k = 0; k < BATCH_WORDS; k++) {
+            done &= reached[k] == 0;
+            for (uint64_t bits = reached[k]; bits != 0; bits &= bits - 1)
+                result[first + 64 * k + __builtin_ctzll(bits)] = level;
+        }
+        if (done)
+            return;
+        swap(visit, next);
+    }
+}
+
+vector<int> DiameterSearch::eccentricities(unsigned threads) const {
+    int n = graph.getNumVertex();
+    int batches = (n + BATCH_SOURCES - 1) / BATCH_SOURCES;
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    threads = max(1u, min(threads, static_cast<unsigned>(batches)));
+
+    // Every worker claims whole batches and writes the eccentricities of their sources only
+    vector<int> result(n, 0);
+    atomic<int> claimed(0);
+    auto work = [&]() {
+        vector<uint64_t> seen(static_cast<size_t>(n) * BATCH_WORDS);
+        vector<uint64_t> visit(seen.size()), next(seen.size());
+        for (int batch; (batch = claimed.fetch_add(1)) < batches;)
+            searchBatch(batch * BATCH_SOURCES, seen, visit, next, result);
+    };
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers) worker.join();
+    return result;
+}
+
+vector<vector<int>> DiameterSearch::longestTrips(int& diameter, unsigned threads) const {
+    vector<int> farthest = eccentricities(threads);
+    diameter = farthest.empty() ? 0 : *max_element(farthest.begin(), farthest.end());
+    vector<int> sources;
+    for (int v = 0; v < graph.getNumVertex() && diameter > 0; v++) {
+        if (farthest[v] == diameter)
+            sources.push_back(v);
+    }
+
+    vector<vector<int>> trips;
+    SearchContext& context = SearchContext::local();
+    for (int source : sources) {
+        eccentricity(source, context);
+        const vector<int>& order = context.queue();
+        for (auto it = order.rbegin(); it != order.rend() && context.distance(*it) == diameter; it++) {
+            vector<int> trip;
+            for (int v = *it; v != -1; v = context.parent(v))
+                trip.push_back(v);
+            reverse(trip.begin(), trip.end());
+            trips.push_back(move(trip));
+        }
+    }
+    return trips;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file DiameterSearch.h
+ * @brief Header file containing the parallel search of the diameter of the airport graph.
+ *
+ * The diameter, the greatest number of flights between two airports when flying the fewest flights, needs a
+ * breadth-first search from every airport. The 'DiameterSearch' class runs them as a multi-source breadth-first
+ * search (MS-BFS): each airport holds one bit per source of a batch of 256 sources, telling which of them already
+ * reached it, so a single pass over the flight routes advances the searches of the whole batch by one flight.
+ * The batches are independent and spread over worker threads. A search only keeps the eccentricity of its source,
+ * the number of flights to its farthest airports: the paths of the longest trips are rebuilt at the end, by a
+ * breadth-first search from each of the few sources whose eccentricity is the diameter.
+ */
+
+#ifndef AED_AIRPORTS_DIAMETERSEARCH_H
+#define AED_AIRPORTS_DIAMETERSEARCH_H
+
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+#include <cstdint>
+
+/**
+ * @class DiameterSearch
+ * @brief Breadth-first searches from every airport of the CSR snapshot, run in bit-parallel batches.
+ */
+class DiameterSearch {
+private:
+    static const int BATCH_WORDS = 4;                   ///< The 64-bit words of the source bits of an airport.
+    static const int BATCH_SOURCES = 64 * BATCH_WORDS;  ///< The sources searched together.
+
+    const FrozenGraph& graph;           ///< The CSR snapshot of the airport graph.
+
+    /**
+     * @brief Runs the breadth-first searches of a batch of sources together.
+     * @param first The vertex ID of the first source, followed by the next ones up to the end of the batch.
+     * @param seen Scratch bits of the sources that reached each airport, BATCH_WORDS words per vertex.
+     * @param visit Scratch bits of the sources whose search reached each airport at the latest level.
+     * @param next Scratch bits of the sources whose search reaches each airport at the next level.
+     * @param result Receives the eccentricity of each source of the batch.
+     *
+     * Time Complexity: O(D*(V+E)) where D stands for the greatest eccentricity of the batch, V for vertices and E for edges.
+     */
+    void searchBatch(int first, vector<uint64_t>& seen, vector<uint64_t>& visit, vector<uint64_t>& next, vector<int>& result) const;
+
+public:
+    /**
+     * @brief Constructor for the DiameterSearch class.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the search.
+     */
+    explicit DiameterSearch(const FrozenGraph& graph);
+
+    /**
+     * @brief Runs a breadth-first search from a single airport.
+     * @param source The vertex ID of the source airport.
+     * @param context The search context receiving the distances and parents, and the airports in visiting order in its queue.
+     * @return The eccentricity of the source, the number of flights to the farthest airport it can reach.
+     *
+     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
+     */
+    int eccentricity(int source, SearchContext& context) const;
+
+    /**
+     * @brief Computes the eccentricity of every airport.
+     * @param threads The number of worker threads (0 uses every hardware thread).
+     * @return The eccentricity of each vertex ID, the number of flights to the farthest airport it can reach.
+     *
+     * Time Complexity: O(V*D*(V+E)/(B*T)) where V stands for vertices, D for the diameter, E for edges, B for the
+     * sources of a batch and T for threads.
+     */
+    vector<int> eccentricities(unsigned threads = 0) const;
+
+    /**
+     * @brief Searches the longest trips, the paths with the fewest flights between the farthest pairs of airports.
+     * @param diameter Receives the diameter, the number of flights of the longest trips (0 if there is no flight).
+     * @param threads The number of worker threads computing the eccentricities (0 uses every hardware thread).
+     * @return The vertex IDs of each longest trip, by source in increasing order, then by reverse visiting order of
+     * the targets.
+     *
+     * Time Complexity: O(V*D*(V+E)/(B*T)+S*(V+E)) where V stands for vertices, D for the diameter, E for edges, B for
+     * the sources of a batch, T for threads and S for the sources of the longest trips.
+     */
+    vector<vector<int>> longestTrips(int& diameter, unsigned threads = 0) const;
+};
+
+#endif //AED_AIRPORTS_DIAMETERSEARCH_H
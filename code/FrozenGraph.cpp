@@ -0,0 +1,43 @@
+#include "FrozenGraph.h"
+
+FrozenGraph::FrozenGraph(const Graph<Airport>& graph) {
+    vertices = graph.getVertexSet();
+    offsets.assign(vertices.size() + 1, 0);
+    airlineOffsets.push_back(0);
+
+    for (auto v : vertices) {
+        for (const auto& flight : v->getAdj()) {
+            targets.push_back(flight.getDest()->getId());
+            distances.push_back(flight.getDistance());
+            airlineIds.insert(airlineIds.end(), flight.getAirlines().begin(), flight.getAirlines().end());
+            airlineOffsets.push_back(static_cast<int>(airlineIds.size()));
+        }
+        offsets[v->getId() + 1] = static_cast<int>(targets.size());
+    }
+
+    // Incoming edges, grouped by destination with a counting sort, in the order of the outgoing ones
+    inOffsets.assign(vertices.size() + 1, 0);
+    for (int target : targets)
+        inOffsets[target + 1]++;
+    for (size_t v = 0; v < vertices.size(); v++)
+        inOffsets[v + 1] += inOffsets[v];
+
+    inEdges.resize(targets.size());
+    sources.resize(targets.size());
+    vector<int> next(inOffsets.begin(), inOffsets.end() - 1);
+    for (int v = 0; v < getNumVertex(); v++) {
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            int i = next[targets[e]]++;
+            inEdges[i] = e;
+            sources[i] = v;
+        }
+    }
+}
+
+int FrozenGraph::findEdge(int source, int target) const {
+    for (int e = offsets[source]; e < offsets[source + 1]; e++) {
+        if (targets[e] == target)
+            return e;
+    }
+    return -1;
+}
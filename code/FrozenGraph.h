@@ -0,0 +1,147 @@
+/**
+ * @file FrozenGraph.h
+ * @brief Header file containing a read-only, compressed sparse row (CSR) snapshot of the airport graph.
+ *
+ * Once the data is parsed the airport graph never changes, so the 'FrozenGraph' class copies it into
+ * contiguous arrays indexed by dense vertex IDs: one offset array per vertex, and target, distance and airline
+ * ranges per edge. Traversals over it are linear scans over those arrays instead of pointer chasing through
+ * separately allocated vertices and per-edge airline sets. The incoming edges of each vertex are indexed as well,
+ * so that searches can also run backward from a target.
+ */
+
+#ifndef AED_AIRPORTS_FROZENGRAPH_H
+#define AED_AIRPORTS_FROZENGRAPH_H
+
+#include "Graph.h"
+#include <cstdint>
+
+/**
+ * @class FrozenGraph
+ * @brief Immutable CSR representation of a Graph<Airport>.
+ *
+ * Vertex IDs are the IDs of the original vertices (Vertex::getId()), edges of vertex 'v' are the indexes
+ * in [edgesBegin(v), edgesEnd(v)) and keep the order of the original adjacency list.
+ * Airline IDs are the ones assigned by the AirlineRegistry.
+ */
+class FrozenGraph {
+private:
+    vector<Vertex<Airport>*> vertices;  ///< The original vertex of each vertex ID.
+    vector<int> offsets;                ///< The edges of vertex 'v' are stored in [offsets[v], offsets[v + 1]).
+    vector<int> targets;                ///< The destination vertex ID of each edge.
+    vector<double> distances;           ///< The distance in kilometers of each edge.
+    vector<int> airlineOffsets;         ///< The airlines of edge 'e' are stored in [airlineOffsets[e], airlineOffsets[e + 1]).
+    vector<AirlineId> airlineIds;        ///< The airline IDs of every edge, stored contiguously.
+    vector<int> inOffsets;              ///< The incoming edges of vertex 'v' are stored in [inOffsets[v], inOffsets[v + 1]).
+    vector<int> inEdges;                ///< The index of each incoming edge, grouped by destination.
+    vector<int> sources;                ///< The source vertex ID of each incoming edge, parallel to 'inEdges'.
+
+public:
+    /**
+     * @brief Constructor for the FrozenGraph class, builds the snapshot of the given graph.
+     * @param graph The airport graph to freeze.
+     *
+     * Time Complexity: O(V+E*A) where A stands for the number of airlines of each edge.
+     */
+    explicit FrozenGraph(const Graph<Airport>& graph);
+
+    /**
+     * @brief Retrieves the number of vertices.
+     * @return The number of vertices.
+     */
+    int getNumVertex() const { return static_cast<int>(vertices.size()); }
+
+    /**
+     * @brief Retrieves the number of edges.
+     * @return The number of edges.
+     */
+    int getNumEdges() const { return static_cast<int>(targets.size()); }
+
+    /**
+     * @brief Retrieves the original vertex of a vertex ID.
+     * @param v The vertex ID.
+     * @return Pointer to the original airport vertex.
+     */
+    Vertex<Airport>* getVertex(int v) const { return vertices[v]; }
+
+    /**
+     * @brief Retrieves the index of the first outgoing edge of a vertex.
+     * @param v The vertex ID.
+     * @return The index of the first edge of 'v'.
+     */
+    int edgesBegin(int v) const { return offsets[v]; }
+
+    /**
+     * @brief Retrieves the index past the last outgoing edge of a vertex.
+     * @param v The vertex ID.
+     * @return The index past the last edge of 'v'.
+     */
+    int edgesEnd(int v) const { return offsets[v + 1]; }
+
+    /**
+     * @brief Retrieves the destination of an edge.
+     * @param e The edge index.
+     * @return The vertex ID of the destination.
+     */
+    int getTarget(int e) const { return targets[e]; }
+
+    /**
+     * @brief Retrieves the distance of an edge.
+     * @param e The edge index.
+     * @return The distance in kilometers.
+     */
+    double getDistance(int e) const { return distances[e]; }
+
+    /**
+     * @brief Retrieves the beginning of the airline IDs range of an edge.
+     * @param e The edge index.
+     * @return Pointer to the first airline ID of the edge.
+     */
+    const AirlineId* airlinesBegin(int e) const { return airlineIds.data() + airlineOffsets[e]; }
+
+    /**
+     * @brief Retrieves the end of the airline IDs range of an edge.
+     * @param e The edge index.
+     * @return Pointer past the last airline ID of the edge.
+     */
+    const AirlineId* airlinesEnd(int e) const { return airlineIds.data() + airlineOffsets[e + 1]; }
+
+    /**
+     * @brief Retrieves the position of the first incoming edge of a vertex.
+     * @param v The vertex ID.
+     * @return The position of the first incoming edge of 'v', to use with getInEdge() and getSource().
+     */
+    int inEdgesBegin(int v) const { return inOffsets[v]; }
+
+    /**
+     * @brief Retrieves the position past the last incoming edge of a vertex.
+     * @param v The vertex ID.
+     * @return The position past the last incoming edge of 'v'.
+     */
+    int inEdgesEnd(int v) const { return inOffsets[v + 1]; }
+
+    /**
+     * @brief Retrieves an incoming edge.
+     * @param i The position of the incoming edge.
+     * @return The edge index.
+     */
+    int getInEdge(int i) const { return inEdges[i]; }
+
+    /**
+     * @brief Retrieves the source of an incoming edge.
+     * @param i The position of the incoming edge.
+     * @return The vertex ID of the source.
+     */
+    int getSource(int i) const { return sources[i]; }
+
+    /**
+     * @brief Finds the edge between two vertices.
+     * @param source The vertex ID of the source.
+     * @param target The vertex ID of the destination.
+     * @return The edge index, -1 if there is no such edge.
+     *
+     * Time Complexity: O(d) where d stands for the number of outgoing edges of the source.
+     */
+    int findEdge(int source, int target) const;
+};
+
+#endif //AED_AIRPORTS_FROZENGRAPH_H
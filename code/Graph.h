@@ -12,15 +12,14 @@
 #ifndef AED_AIRPORTS_GRAPH_H
 #define AED_AIRPORTS_GRAPH_H
 
-#include "Data.h"
+#include "AirlineRegistry.h"
 #include <cstddef>
 #include <vector>
 #include <queue>
-#include <stack>
-#include <list>
 #include <string>
 #include <set>
 #include <unordered_map>
+#include <algorithm>
 
 using namespace std;
 
@@ -38,13 +37,10 @@ template <class T> class Vertex;
 template <class T>
 class Vertex {
     T info;                 ///< The information contained in the vertex.
+    int id = -1;            ///< The dense index of the vertex in the graph's vertex set.
     vector<Edge<T>> adj;    ///< The list of adjacent edges.
-    bool visited;           ///< Indicates if the vertex has been visited.
-    bool processing;        ///< Indicates if the vertex is being processed.
     int inDegree;           ///< The number of edges directed towards the vertex.
     int outDegree;          ///< The number of edges directed away from the vertex.
-    int num;                ///< The numerical value used in graph algorithms.
-    int low;                ///< The low value used in graph algorithms.
     int flightsTo = 0;      ///< The number of flights to this vertex.
     int flightsFrom = 0;    ///< The number of flights from this vertex.
 
@@ -82,28 +78,10 @@ public:
     void setInfo(T in);
 
     /**
-     * @brief Checks if the vertex has been visited.
-     * @return True if the vertex has been visited, otherwise false.
+     * @brief Retrieves the dense ID of the vertex (its position in the graph's vertex set).
+     * @return The ID of the vertex, or -1 if it does not belong to a graph.
      */
-    bool isVisited() const;
-
-    /**
-     * @brief Sets the visit status of the vertex.
-     * @param v Boolean indicating whether the vertex has been visited.
-     */
-    void setVisited(bool v);
-
-    /**
-     * @brief Checks if the vertex is being processed.
-     * @return True if the vertex is being processed, otherwise false.
-     */
-    bool isProcessing() const;
-
-    /**
-     * @brief Sets the processing status of the vertex.
-     * @param p Boolean indicating whether the vertex is being processed.
-     */
-    void setProcessing(bool p);
+    int getId() const;
 
     /**
      * @brief Retrieves the list of adjacent edges.
@@ -114,6 +92,7 @@ public:
     /**
      * @brief Sets the list of adjacent edges for the vertex.
      * @param adj The list of adjacent edges to be set.
+     * @note Edges set this way bypass the edge index of the graph, use Graph::addEdge to keep Graph::findEdge consistent.
      */
     void setAdj(const vector<Edge<T>> &adj);
 
@@ -141,30 +120,6 @@ public:
      */
     void setOutDegree(int outDegree);
 
-    /**
-     * @brief Retrieves the numerical value used in graph algorithms.
-     * @return The numerical value of the vertex.
-     */
-    int getNum() const;
-
-    /**
-     * @brief Sets the numerical value used in graph algorithms.
-     * @param num The numerical value to set.
-     */
-    void setNum(int num);
-
-    /**
-     * @brief Retrieves the low value used in graph algorithms.
-     * @return The low value of the vertex.
-     */
-    int getLow() const;
-
-    /**
-     * @brief Sets the low value used in graph algorithms.
-     * @param low The low value to set.
-     */
-    void setLow(int low);
-
     /**
      * @brief Retrieves the number of flights to this vertex.
      * @return The number of flights to the vertex.
@@ -203,14 +158,14 @@ public:
  * @brief Class representing an edge in a graph connecting two vertices.
  *
  * An Edge object defines a connection between two vertices in a graph.
- * It holds information about the destination vertex, distance, and associated airlines.
+ * It holds information about the destination vertex, distance, and the IDs of the associated airlines.
  * @tparam T The data type of the vertex.
  */
 template <class T>
 class Edge {
-    Vertex<T>* dest;            ///< Pointer to the destination vertex.
-    double distance;            ///< The distance between source and destination vertices in kilometers.
-    std::set<Airline> airlines; ///< The set of airlines associated with this edge.
+    Vertex<T>* dest;                    ///< Pointer to the destination vertex.
+    double distance;                    ///< The distance between source and destination vertices in kilometers.
+    std::vector<AirlineId> airlines;    ///< The sorted IDs of the airlines associated with this edge.
 
 public:
     /**
@@ -233,16 +188,16 @@ public:
     void setDest(Vertex<T> *dest);
 
     /**
-     * @brief Retrieves the set of airlines associated with this edge.
-     * @return Constant reference to the set of airlines.
+     * @brief Retrieves the IDs of the airlines associated with this edge.
+     * @return Constant reference to the sorted vector of airline IDs.
      */
-    const std::set<Airline>& getAirlines() const;
+    const std::vector<AirlineId>& getAirlines() const;
 
     /**
-     * @brief Adds an airline to the set associated with this edge.
-     * @param airline The airline to add.
+     * @brief Adds an airline to the ones associated with this edge, keeping the IDs sorted and unique.
+     * @param airline The ID of the airline to add.
      */
-    void addAirline(const Airline& airline);
+    void addAirline(AirlineId airline);
 
     /**
      * @brief Retrieves the distance of this edge.
@@ -280,30 +235,78 @@ public:
  * The Graph class defines a directed graph structure using vertices and edges.
  * It supports various graph operations like adding/removing vertices, edges,
  * performing depth-first search (DFS), breadth-first search (BFS), topological sorting, etc.
- * @tparam T The data type of the graph vertices.
+ * Vertices are indexed by their key (T::getCode()) and edges by their (source ID, destination ID) pair,
+ * so that lookups do not scan the vertex set or the adjacency lists.
+ * @tparam T The data type of the graph vertices, it must provide a unique getCode() key.
  */
 template <class T>
 class Graph {
-    vector<Vertex<T>*> vertexSet;   ///< The collection of vertices in the graph.
-    int _index_;                    ///< The used internally.
-    stack<Vertex<T>> _stack_;       ///< The stack used internally.
-    list<list<T>> _list_sccs_;      ///< The list of strongly connected components.
+    vector<Vertex<T>*> vertexSet;                   ///< The collection of vertices in the graph.
+    unordered_map<string, Vertex<T>*> vertexIndex;  ///< Hash index from the vertex key (T::getCode()) to its vertex.
+    unordered_map<uint64_t, int> edgeIndex;         ///< Hash index from the (source ID, destination ID) pair to the position of the edge in the source adjacency list.
 
     /**
      * @brief Performs a depth-first search visit starting from a given vertex.
      * @param v Pointer to the starting vertex.
+     * @param visited Indicates which vertices (by ID) have been visited.
      * @param res Vector containing the visited vertices.
      */
-    void dfsVisit(Vertex<T> *v, vector<T> &res) const;
+    void dfsVisit(Vertex<T> *v, vector<bool> &visited, vector<T> &res) const;
+
+    /**
+     * @brief Computes the key of an edge in the edge index.
+     * @param source ID of the source vertex.
+     * @param dest ID of the destination vertex.
+     * @return The key packing both IDs.
+     */
+    static uint64_t edgeKey(int source, int dest) { return (uint64_t(uint32_t(source)) << 32) | uint32_t(dest); }
+
+    /**
+     * @brief Rebuilds the edge index after edges were removed or vertex IDs changed.
+     */
+    void rebuildEdgeIndex();
 
 public:
     /**
      * @brief Finds a vertex in the graph based on the given information.
      * @param in The information to search for.
      * @return Pointer to the vertex if found, nullptr otherwise.
+     *
+     * Time Complexity: O(1) on average, the lookup goes through the key index.
      */
     Vertex<T> *findVertex(const T &in) const;
 
+    /**
+     * @brief Finds a vertex in the graph based on its key (the code returned by T::getCode(), e.g. the airport IATA code).
+     * @param key The key of the vertex to search for.
+     * @return Pointer to the vertex if found, nullptr otherwise.
+     *
+     * Time Complexity: O(1) on average.
+     */
+    Vertex<T> *findVertexByKey(const string &key) const;
+
+    /**
+     * @brief Finds the edge from a vertex to another.
+     * @param source Pointer to the source vertex.
+     * @param dest Pointer to the destination vertex.
+     * @return Pointer to the first edge from 'source' to 'dest' if found, nullptr otherwise.
+     * The pointer is valid until another edge is added to or removed from the source vertex.
+     *
+     * Time Complexity: O(1) on average.
+     */
+    const Edge<T> *findEdge(const Vertex<T> *source, const Vertex<T> *dest) const;
+
+    /**
+     * @brief Finds the edge from a vertex to another, allowing it to be modified.
+     * @param source Pointer to the source vertex.
+     * @param dest Pointer to the destination vertex.
+     * @return Pointer to the first edge from 'source' to 'dest' if found, nullptr otherwise.
+     * The pointer is valid until another edge is added to or removed from the source vertex.
+     *
+     * Time Complexity: O(1) on average.
+     */
+    Edge<T> *findEdge(const Vertex<T> *source, const Vertex<T> *dest);
+
     /**
      * @brief Retrieves the number of vertices in the graph.
      * @return The number of vertices in the graph.
@@ -339,6 +342,15 @@ public:
      */
     bool addEdge(const T &source, const T &dest, double distance);
 
+    /**
+     * @brief Adds a directed edge between two vertices of the graph, without looking them up.
+     * @param source Pointer to the source vertex.
+     * @param dest Pointer to the destination vertex.
+     * @param distance The distance between the source and destination vertices.
+     * @return Reference to the new edge, valid until another edge is added to the source vertex.
+     */
+    Edge<T> &addEdge(Vertex<T> *source, Vertex<T> *dest, double distance);
+
     /**
      * @brief Removes a directed edge between two vertices in the graph.
      * @param source Information of the source vertex.
@@ -394,17 +406,8 @@ T Vertex<T>::getInfo() const { return info; }
 template<class T>
 void Vertex<T>::setInfo(T in) { Vertex::info = in; }
 
-template <class T>
-bool Vertex<T>::isVisited() const { return visited; }
-
-template <class T>
-void Vertex<T>::setVisited(bool v) { Vertex::visited = v; }
-
 template<class T>
-bool Vertex<T>::isProcessing() const { return processing; }
-
-template<class T>
-void Vertex<T>::setProcessing(bool p) { Vertex::processing = p; }
+int Vertex<T>::getId() const { return id; }
 
 template<class T>
 const vector<Edge<T>> &Vertex<T>::getAdj() const { return adj; }
@@ -424,18 +427,6 @@ int Vertex<T>::getOutDegree() const { return outDegree; }
 template<class T>
 void Vertex<T>::setOutDegree(int outDegree) { Vertex::outDegree = outDegree; }
 
-template<class T>
-int Vertex<T>::getNum() const { return num; }
-
-template<class T>
-void Vertex<T>::setNum(int num) { Vertex::num = num; }
-
-template<class T>
-int Vertex<T>::getLow() const { return low; }
-
-template<class T>
-void Vertex<T>::setLow(int low) { Vertex::low = low; }
-
 template<class T>
 int Vertex<T>::getFlightsTo() const { return flightsTo; }
 
@@ -460,10 +451,14 @@ template<class T>
 void Edge<T>::setDest(Vertex<T> *d) { Edge::dest = d; }
 
 template<class T>
-const std::set<Airline>& Edge<T>::getAirlines() const { return airlines; }
+const std::vector<AirlineId>& Edge<T>::getAirlines() const { return airlines; }
 
 template<class T>
-void Edge<T>::addAirline(const Airline& airline) { airlines.insert(airline); }
+void Edge<T>::addAirline(AirlineId airline) {
+    auto it = lower_bound(airlines.begin(), airlines.end(), airline);
+    if (it == airlines.end() || *it != airline)
+        airlines.insert(it, airline);
+}
 
 template<class T>
 double Edge<T>::getDistance() const { return distance; }
@@ -475,11 +470,36 @@ void Edge<T>::setDistance(double distance) { Edge::distance = distance; }
 
 template <class T>
 Vertex<T> *Graph<T>::findVertex(const T &in) const {
-    for (auto v : vertexSet) {
-        if (v->info == in)
-            return v;
-    }
-    return NULL;
+    return findVertexByKey(in.getCode());
+}
+
+template <class T>
+Vertex<T> *Graph<T>::findVertexByKey(const string &key) const {
+    auto it = vertexIndex.find(key);
+    if (it == vertexIndex.end())
+        return NULL;
+    return it->second;
+}
+
+template <class T>
+const Edge<T> *Graph<T>::findEdge(const Vertex<T> *source, const Vertex<T> *dest) const {
+    auto it = edgeIndex.find(edgeKey(source->id, dest->id));
+    if (it == edgeIndex.end())
+        return NULL;
+    return &source->adj[it->second];
+}
+
+template <class T>
+Edge<T> *Graph<T>::findEdge(const Vertex<T> *source, const Vertex<T> *dest) {
+    return const_cast<Edge<T>*>(static_cast<const Graph<T>*>(this)->findEdge(source, dest));
+}
+
+template <class T>
+void Graph<T>::rebuildEdgeIndex() {
+    edgeIndex.clear();
+    for (auto v : vertexSet)
+        for (int i = 0; i < v->adj.size(); i++)
+            edgeIndex.emplace(edgeKey(v->id, v->adj[i].dest->id), i);
 }
 
 template <class T>
@@ -490,24 +510,30 @@ vector<Vertex<T>*> Graph<T>::getVertexSet() const { return vertexSet; }
 
 template <class T>
 bool Graph<T>::addVertex(const T &in) {
-    if (findVertex(in) != NULL)
+    if (vertexIndex.count(in.getCode()) != 0)
         return false;
-    vertexSet.push_back(new Vertex<T>(in));
+    auto v = new Vertex<T>(in);
+    v->id = static_cast<int>(vertexSet.size());
+    vertexIndex[in.getCode()] = v;
+    vertexSet.push_back(v);
     return true;
 }
 
 template <class T>
 bool Graph<T>::removeVertex(const T &in) {
-    for (auto it = vertexSet.begin(); it != vertexSet.end(); it++)
-        if ((*it)->info  == in) {
-            auto v = *it;
-            vertexSet.erase(it);
-            for (auto u : vertexSet)
-                u->removeEdgeTo(v);
-            delete v;
-            return true;
-        }
-    return false;
+    auto found = vertexIndex.find(in.getCode());
+    if (found == vertexIndex.end())
+        return false;
+    auto v = found->second;
+    vertexIndex.erase(found);
+    vertexSet.erase(vertexSet.begin() + v->id);
+    for (int i = v->id; i < vertexSet.size(); i++)
+        vertexSet[i]->id = i;
+    for (auto u : vertexSet)
+        u->removeEdgeTo(v);
+    delete v;
+    rebuildEdgeIndex();
+    return true;
 }
 
 template <class T>
@@ -516,10 +542,17 @@ bool Graph<T>::addEdge(const T &source, const T &dest, double distance) {
     auto v2 = findVertex(dest);
     if (v1 == NULL || v2 == NULL)
         return false;
-    v1->addEdge(v2, distance);
+    addEdge(v1, v2, distance);
     return true;
 }
 
+template <class T>
+Edge<T> &Graph<T>::addEdge(Vertex<T> *source, Vertex<T> *dest, double distance) {
+    source->addEdge(dest, distance);
+    edgeIndex.emplace(edgeKey(source->id, dest->id), static_cast<int>(source->adj.size()) - 1);
+    return source->adj.back();
+}
+
 template <class T>
 void Vertex<T>::addEdge(Vertex<T> *d,  double distance) {
     adj.push_back(Edge<T>(d, distance));
@@ -531,7 +564,10 @@ bool Graph<T>::removeEdge(const T &source, const T &dest) {
     auto v2 = findVertex(dest);
     if (v1 == NULL || v2 == NULL)
         return false;
-    return v1->removeEdgeTo(v2);
+    if (!v1->removeEdgeTo(v2))
+        return false;
+    rebuildEdgeIndex();
+    return true;
 }
 
 template <class T>
@@ -564,22 +600,21 @@ void Graph<T>::setupInDegreeAndOutDegree() {
 template <class T>
 vector<T> Graph<T>::dfs() const {
     vector<T> res;
+    vector<bool> visited(vertexSet.size(), false);
     for (auto v : vertexSet)
-        v->visited = false;
-    for (auto v : vertexSet)
-        if (! v->visited)
-            dfsVisit(v, res);
+        if (! visited[v->id])
+            dfsVisit(v, visited, res);
     return res;
 }
 
 template <class T>
-void Graph<T>::dfsVisit(Vertex<T> *v, vector<T> &res) const {
-    v->visited = true;
+void Graph<T>::dfsVisit(Vertex<T> *v, vector<bool> &visited, vector<T> &res) const {
+    visited[v->id] = true;
     res.push_back(v->info);
     for (auto &e : v->adj) {
         auto w = e.dest;
-        if (!w->visited)
-            dfsVisit(w, res);
+        if (!visited[w->id])
+            dfsVisit(w, visited, res);
     }
 }
 
@@ -590,10 +625,8 @@ vector<T> Graph<T>::dfs(const T &source) const {
     if (s == nullptr)
         return res;
 
-    for (auto v : vertexSet)
-        v->visited = false;
-
-    dfsVisit(s, res);
+    vector<bool> visited(vertexSet.size(), false);
+    dfsVisit(s, visited, res);
     return res;
 }
 
@@ -606,19 +639,18 @@ vector<T> Graph<T>::bfs(const T &source) const {
     if (s == NULL)
         return res;
     queue<Vertex<T> *> q;
-    for (auto v : vertexSet)
-        v->visited = false;
+    vector<bool> visited(vertexSet.size(), false);
     q.push(s);
-    s->visited = true;
+    visited[s->id] = true;
     while (!q.empty()) {
         auto v = q.front();
         q.pop();
         res.push_back(v->info);
         for (auto & e : v->adj) {
             auto w = e.dest;
-            if ( ! w->visited ) {
+            if ( ! visited[w->id] ) {
                 q.push(w);
-                w->visited = true;
+                visited[w->id] = true;
             }
         }
     }
@@ -630,7 +662,7 @@ vector<T> Graph<T>::bfs(const T &source) const {
 template<class T>
 vector<T> Graph<T>::topsort() const {
     vector<T> res;
-    queue<Vertex<T>> q;
+    queue<Vertex<T>*> q;
 
     for (auto v : vertexSet)
         v->inDegree = 0;
@@ -643,18 +675,18 @@ vector<T> Graph<T>::topsort() const {
 
     for (auto v : vertexSet) {
         if (v->inDegree == 0)
-            q.push(*v);
+            q.push(v);
     }
 
     while (!q.empty()) {
         auto vertex = q.front();
-        for (auto &e : vertex.getAdj()) {
+        for (auto &e : vertex->getAdj()) {
             e.dest->inDegree--;
             if (e.dest->inDegree == 0)
-                q.push(*e.dest);
+                q.push(e.dest);
         }
         q.pop();
-        res.push_back(vertex.getInfo());
+        res.push_back(vertex->getInfo());
     }
     return res;
 }
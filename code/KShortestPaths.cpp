@@ -0,0 +1,134 @@
+#include "KShortestPaths.h"
+#include <limits>
+
+static const double INFINITE_COST = numeric_limits<double>::infinity();
+
+// Adds two (primary, secondary) costs
+static pair<double, double> addCosts(const pair<double, double>& a, const pair<double, double>& b) {
+    return {a.first + b.first, a.second + b.second};
+}
+
+KShortestPaths::KShortestPaths(const FrozenGraph& graph, int source, int target, RouteObjective objective, SearchContext& context)
+    : graph(graph), source(source), target(target), objective(objective),
+      remaining(graph.getNumVertex(), {INFINITE_COST, INFINITE_COST}) {
+    // Dijkstra's algorithm backward from the target, over the incoming edges
+    context.begin(graph.getNumVertex());
+    auto& heap = context.heap();
+    remaining[target] = {0, 0};
+    heap.push(remaining[target], target);
+    while (!heap.empty()) {
+        int w = heap.top().second;
+        heap.pop();
+        if (context.isProcessing(w))
+            continue;
+        context.setProcessing(w, true);
+        for (int i = graph.inEdgesBegin(w); i < graph.inEdgesEnd(w); i++) {
+            int v = graph.getSource(i);
+            pair<double, double> through = addCosts(remaining[w], edgeCost(graph.getInEdge(i)));
+            if (through < remaining[v]) {
+                remaining[v] = through;
+                heap.push(through, v);
+            }
+        }
+    }
+}
+
+pair<double, double> KShortestPaths::edgeCost(int e) const {
+    if (objective == RouteObjective::DISTANCE)
+        return {graph.getDistance(e), 1};
+    return {1, graph.getDistance(e)};
+}
+
+int KShortestPaths::spurSearch(const Candidate& base, int spur, SearchContext& context) {
+    context.begin(graph.getNumVertex());
+    for (int i = 0; i < spur; i++)
+        context.setMark(base.path[i], 1);
+
+    // The routes produced with the same prefix already took these flight routes out of the spur airport
+    vector<int> taken;
+    for (int index : found) {
+        const vector<int>& path = candidates[index].path;
+        if (static_cast<int>(path.size()) > spur + 1 && equal(path.begin(), path.begin() + spur + 1, base.path.begin()))
+            taken.push_back(path[spur + 1]);
+    }
+
+    int start = base.path[spur];
+    auto& heap = context.heap();
+    context.setVisited(start);
+    context.cost(start) = base.prefixes[spur];
+    context.parent(start) = -1;
+    heap.push(addCosts(context.cost(start), remaining[start]), start);
+
+    int settled = 0;
+    while (!heap.empty()) {
+        int v = heap.top().second;
+        heap.pop();
+        if (context.isProcessing(v))
+            continue;
+        context.setProcessing(v, true);
+        settled++;
+        if (v == target)
+            break;
+
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getTarget(e);
+            if (context.isMarked(w) || context.isProcessing(w) || remaining[w].first == INFINITE_COST)
+                continue;
+            if (v == start && find(taken.begin(), taken.end(), w) != taken.end())
+                continue;
+
+            pair<double, double> cost = addCosts(context.cost(v), edgeCost(e));
+            if (!context.isVisited(w))
+                context.setVisited(w);
+            else if (!(cost < context.cost(w)))
+                continue;
+            context.cost(w) = cost;
+            context.parent(w) = v;
+            heap.push(addCosts(cost, remaining[w]), w);
+        }
+    }
+    if (!context.isProcessing(target))
+        return settled;
+
+    Candidate candidate;
+    for (int v = target; v != -1; v = context.parent(v)) {
+        candidate.path.push_back(v);
+        candidate.prefixes.push_back(context.cost(v));
+    }
+    candidate.path.insert(candidate.path.end(), base.path.rend() - spur, base.path.rend());
+    candidate.prefixes.insert(candidate.prefixes.end(), base.prefixes.rend() - spur, base.prefixes.rend());
+    reverse(candidate.path.begin(), candidate.path.end());
+    reverse(candidate.prefixes.begin(), candidate.prefixes.end());
+
+    if (known.insert(candidate.path).second) {
+        queue.push(candidate.prefixes.back(), static_cast<int>(candidates.size()));
+        candidates.push_back(move(candidate));
+    }
+    return settled;
+}
+
+bool KShortestPaths::next(Route& route, SearchContext& context) {
+    route = Route();
+    if (!started) {
+        started = true;
+        if (source != target)
+            route.settled += spurSearch({{source}, {{0, 0}}}, 0, context);
+    } else if (expanded < static_cast<int>(found.size())) {
+        // Every spur search appends to the candidates, so the last route is copied first
+        expanded = static_cast<int>(found.size());
+        Candidate last = candidates[found.back()];
+        for (int spur = 0; spur + 1 < static_cast<int>(last.path.size()); spur++)
+            route.settled += spurSearch(last, spur, context);
+    }
+    if (queue.empty())
+        return false;
+
+    int index = queue.top().second;
+    queue.pop();
+    found.push_back(index);
+    const Candidate& best = candidates[index];
+    for (int v : best.path)
+        route.airports.push_back(graph.getVertex(v));
+    route.distance = objective == RouteObjective::DISTANCE ? best.prefixes.back().first : best.prefixes.back().second;
+    return true;
+}
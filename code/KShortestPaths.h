@@ -0,0 +1,104 @@
+/**
+ * @file KShortestPaths.h
+ * @brief Header file containing the lazy enumeration of the K best loopless routes between two airports.
+ *
+ * This file defines the 'KShortestPaths' class, Yen's algorithm over the CSR snapshot of the airport graph. Each
+ * route is derived from the previous ones by a spur search per airport of the last route found, that leaves its
+ * prefix through a flight route no previous route with the same prefix took, and avoids the airports of the
+ * prefix. The routes are produced one at a time, so asking for the best K routes only runs the spur searches of
+ * the first K-1. The exact cost left from every airport to the target is computed once by a backward search,
+ * and the spur searches are A* searches guided by it: the removed airports and flight routes only make the true
+ * cost larger, so the guide stays a consistent lower bound and each spur search settles little more than the
+ * airports of its own route.
+ */
+
+#ifndef AED_AIRPORTS_KSHORTESTPATHS_H
+#define AED_AIRPORTS_KSHORTESTPATHS_H
+
+#include "AStarRouter.h"
+#include "DaryHeap.h"
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+#include <set>
+
+/**
+ * @class KShortestPaths
+ * @brief The loopless routes from a source airport to a target airport, produced in order of increasing cost.
+ *
+ * The enumeration keeps its own state between routes, and only borrows a search context during each call, so
+ * other queries may run in between. Routes of equal cost are produced in an unspecified order.
+ */
+class KShortestPaths {
+private:
+    /**
+     * @struct Candidate
+     * @brief A route found by a spur search, waiting to be produced.
+     */
+    struct Candidate {
+        vector<int> path;                       ///< The vertex IDs of the route, from the source to the target.
+        vector<pair<double, double>> prefixes;  ///< The cost of the route up to each of its airports.
+    };
+
+    const FrozenGraph& graph;                   ///< The CSR snapshot of the airport graph.
+    int source;                                 ///< The vertex ID of the source airport.
+    int target;                                 ///< The vertex ID of the target airport.
+    RouteObjective objective;                   ///< The minimized cost.
+    vector<pair<double, double>> remaining;     ///< The cost left from each vertex to the target, infinite if it cannot reach it.
+    vector<Candidate> candidates;               ///< The candidate routes, including the ones already produced.
+    vector<int> found;                          ///< The candidates produced so far, in order.
+    DaryHeap<pair<double, double>, int> queue;  ///< The candidates not produced yet, by total cost.
+    set<vector<int>> known;                     ///< The vertex IDs of every route found, to discard duplicate candidates.
+    bool started = false;                       ///< True once the best route was searched.
+    int expanded = 0;                           ///< The number of routes produced whose spur searches were run.
+
+    /**
+     * @brief Retrieves the cost of a flight route.
+     * @param e The edge index of the flight route.
+     * @return The (primary, secondary) cost of the flight route for the objective.
+     */
+    pair<double, double> edgeCost(int e) const;
+
+    /**
+     * @brief Searches the best route from an airport of a route, leaving its prefix through a flight route no route
+     * produced with the same prefix took, and queues the prefix followed by that route as a candidate.
+     * @param base The route, the last one produced (or the source alone for the best route).
+     * @param spur The position of the airport in the route.
+     * @param context The search context of the spur search.
+     * @return The number of vertices settled by the spur search.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges, usually much less.
+     */
+    int spurSearch(const Candidate& base, int spur, SearchContext& context);
+
+public:
+    /**
+     * @brief Constructor for the KShortestPaths class, computes the cost left from every airport to the target.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the enumeration.
+     * @param source The vertex ID of the source airport.
+     * @param target The vertex ID of the target airport (a route from an airport to itself is never loopless).
+     * @param objective The minimized cost.
+     * @param context The search context of the backward search.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges.
+     */
+    KShortestPaths(const FrozenGraph& graph, int source, int target, RouteObjective objective, SearchContext& context);
+
+    /**
+     * @brief Produces the next best loopless route.
+     * @param route Receives the route, its distance and the number of vertices settled by the spur searches of this call.
+     * @param context The search context of the spur searches.
+     * @return True if there was one more route, otherwise false.
+     *
+     * Time Complexity: O(N*(V+E)*log(V)) where N stands for the airports of the previous route, V for vertices and
+     * E for edges, usually close to N times the airports of a route.
+     */
+    bool next(Route& route, SearchContext& context);
+
+    /**
+     * @brief Retrieves the number of routes produced so far.
+     * @return The number of routes.
+     */
+    int getCount() const { return static_cast<int>(found.size()); }
+};
+
+#endif //AED_AIRPORTS_KSHORTESTPATHS_H
@@ -11,13 +11,14 @@
 /**
  * @brief Converts airport graph data into a text file format.
  * @param airportGraph The graph containing airport information.
+ * @param airlineRegistry The registry used to retrieve the airlines of each flight route.
  * @param filename The name of the file to which the data will be written.
  *
  * This function takes an airport graph and writes its information, including airport codes, names,
  * locations (city, country, coordinates), and flight routes, to a specified text file.
  */
 
-inline void convertDataGraphToTextFile(const Graph<Airport>& airportGraph, const std::string& filename) {
+inline void convertDataGraphToTextFile(const Graph<Airport>& airportGraph, const AirlineRegistry& airlineRegistry, const std::string& filename) {
     std::ofstream outFile(filename);
     if (!outFile.is_open()) {
         std::cerr << "Error: Unable to open file " << filename << std::endl;
@@ -38,7 +39,8 @@ inline void convertDataGraphToTextFile(const Graph<Airport>& airportGraph, const
             outFile << "    • " << airport.getCode() << " -> " << target.getCode() << " : " << e.getDistance() << " km" << std::endl;
             outFile << "        by Airlines: " << std::endl;
             int i = 1;
-            for (const auto& airline : e.getAirlines()) {
+            for (auto airlineId : e.getAirlines()) {
+                const auto& airline = airlineRegistry.getAirline(airlineId);
                 outFile << "            " << i++ << ".(" << airline.getCode() << ") " << airline.getCallsign() << std::endl;
             }
             outFile << std::endl;
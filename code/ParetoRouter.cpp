@@ -0,0 +1,199 @@
+#include "ParetoRouter.h"
+#include "DaryHeap.h"
+#include <limits>
+#include <tuple>
+
+// Keeps the distance bounds below the distances despite their rounding
+static const double ESTIMATE_SLACK = 1 - 1e-9;
+
+ParetoRouter::ParetoRouter(const FrozenGraph& graph) : graph(graph) {}
+
+vector<ParetoItinerary> ParetoRouter::search(const vector<int>& sources, const vector<int>& targets, const vector<int>& layovers,
+                                             int maxLabels, SearchContext& context) const {
+    // A state is vertex * (layovers + 1) + layovers visited, complete itineraries all end at the sink state
+    int legLayers = static_cast<int>(layovers.size()) + 1;
+    int sink = graph.getNumVertex() * legLayers;
+    context.begin(sink + 1);
+    for (int target : targets)
+        context.setMark(target, 1);
+
+    // Bound the flights and the distance left from every state with a backward search per leg, from its last leg
+    // to its first one: backwardDistance(state) and estimate(state) are exact if airlines are ignored, and a state
+    // not visited backward cannot reach the targets at all
+    vector<int>& q = context.backwardQueue();
+    auto& heap = context.heap();
+    for (int leg = legLayers - 1; leg >= 0; leg--) {
+        int beyond = leg == legLayers - 1 ? -1 : layovers[leg] * legLayers + leg + 1;
+        if (beyond != -1 && !context.isVisitedBackward(beyond))
+            break;
+        q.clear();
+        for (int seed : leg == legLayers - 1 ? targets : vector<int>{layovers[leg]}) {
+            int state = seed * legLayers + leg;
+            if (context.isVisitedBackward(state))
+                continue;
+            context.setVisitedBackward(state);
+            context.backwardDistance(state) = beyond == -1 ? 0 : context.backwardDistance(beyond);
+            context.estimate(state) = beyond == -1 ? 0 : context.estimate(beyond);
+            q.push_back(seed);
+            heap.push({context.estimate(state), 0}, seed);
+        }
+        for (size_t head = 0; head < q.size(); head++) {
+            int w = q[head];
+            for (int i = graph.inEdgesBegin(w); i < graph.inEdgesEnd(w); i++) {
+                int state = graph.getSource(i) * legLayers + leg;
+                if (context.isVisitedBackward(state))
+                    continue;
+                context.setVisitedBackward(state);
+                context.backwardDistance(state) = context.backwardDistance(w * legLayers + leg) + 1;
+                context.estimate(state) = numeric_limits<double>::max();
+                q.push_back(graph.getSource(i));
+            }
+        }
+        while (!heap.empty()) {
+            int w = heap.top().second;
+            double distance = heap.top().first.first;
+            heap.pop();
+            if (distance > context.estimate(w * legLayers + leg))
+                continue;
+            for (int i = graph.inEdgesBegin(w); i < graph.inEdgesEnd(w); i++) {
+                int state = graph.getSource(i) * legLayers + leg;
+                double through = distance + graph.getDistance(graph.getInEdge(i));
+                if (through < context.estimate(state)) {
+                    context.estimate(state) = through;
+                    heap.push({through, 0}, graph.getSource(i));
+                }
+            }
+        }
+    }
+
+    // The settled labels of a state are linked from parent(state), distance(state) counts them
+    auto reach = [&](int state) {
+        if (context.isVisited(state))
+            return;
+        context.setVisited(state);
+        context.parent(state) = -1;
+        context.distance(state) = 0;
+    };
+
+    vector<Label> labels;
+    vector<AirlineId> pool;
+    DaryHeap<tuple<int, double, int>, int> queue;
+
+    // 'a' dominates 'b' if it is no worse on every cost and can fly on as any airline 'b' can, changing if needed
+    auto covers = [&](const Label& a, const Label& b) {
+        if (a.airlinesBegin == -1)
+            return true;
+        if (b.airlinesBegin == -1)
+            return false;
+        return includes(pool.begin() + a.airlinesBegin, pool.begin() + a.airlinesEnd,
+                        pool.begin() + b.airlinesBegin, pool.begin() + b.airlinesEnd);
+    };
+    auto dominates = [&](const Label& a, const Label& b) {
+        if (a.flights > b.flights || a.distance > b.distance || a.changes > b.changes)
+            return false;
+        return b.state == sink || a.changes < b.changes || covers(a, b);
+    };
+    auto dominated = [&](const Label& label) {
+        if (label.state != sink && context.distance(label.state) >= maxLabels)
+            return true;
+        for (int i = context.parent(label.state); i != -1; i = labels[i].next) {
+            if (dominates(labels[i], label))
+                return true;
+        }
+        if (label.state == sink)
+            return false;
+
+        // No completion of the label can beat an itinerary already found
+        int flightsLeft = max(1, context.backwardDistance(label.state));
+        double left = context.estimate(label.state) * ESTIMATE_SLACK;
+        for (int i = context.parent(sink); i != -1; i = labels[i].next) {
+            if (labels[i].flights <= label.flights + flightsLeft && labels[i].distance <= label.distance + left &&
+                labels[i].changes <= label.changes)
+                return true;
+        }
+        return false;
+    };
+    // A label that is not kept releases its airlines, always the last ones of the pool
+    auto push = [&](const Label& label) {
+        reach(label.state);
+        if ((label.state != sink && !context.isVisitedBackward(label.state)) || dominated(label)) {
+            if (label.airlinesBegin != -1)
+                pool.resize(label.airlinesBegin);
+            return;
+        }
+        labels.push_back(label);
+        int flightsLeft = label.state == sink ? 0 : context.backwardDistance(label.state);
+        double left = label.state == sink ? 0 : context.estimate(label.state);
+        queue.push(make_tuple(label.flights + flightsLeft, label.distance + left, label.changes), static_cast<int>(labels.size()) - 1);
+    };
+
+    reach(sink);
+    for (int source : sources)
+        push({source * legLayers, source, 0, 0, 0, -1, false, -1, -1, -1});
+
+    vector<int> front;
+    while (!queue.empty()) {
+        int index = queue.top().second;
+        queue.pop();
+        Label label = labels[index];
+        if (dominated(label))
+            continue;
+        labels[index].next = context.parent(label.state);
+        context.parent(label.state) = index;
+        context.distance(label.state)++;
+        if (label.state == sink) {
+            front.push_back(index);
+            continue;
+        }
+
+        int leg = label.state % legLayers;
+        for (int e = graph.edgesBegin(label.vertex); e < graph.edgesEnd(label.vertex); e++) {
+            int w = graph.getTarget(e);
+            int nextLeg = (leg < legLayers - 1 && w == layovers[leg]) ? leg + 1 : leg;
+            Label next = {leg == legLayers - 1 && context.isMarked(w) ? sink : w * legLayers + nextLeg, w,
+                          label.flights + 1, label.distance + graph.getDistance(e), label.changes, index, false, -1, -1, -1};
+
+            // Keep flying one of the current airlines, then change to any airline of the flight route
+            int served = static_cast<int>(graph.airlinesEnd(e) - graph.airlinesBegin(e));
+            if (label.airlinesBegin != -1) {
+                next.airlinesBegin = static_cast<int>(pool.size());
+                set_intersection(pool.begin() + label.airlinesBegin, pool.begin() + label.airlinesEnd,
+                                 graph.airlinesBegin(e), graph.airlinesEnd(e), back_inserter(pool));
+                next.airlinesEnd = static_cast<int>(pool.size());
+                int kept = next.airlinesEnd - next.airlinesBegin;
+                if (kept > 0)
+                    push(next);
+                if (kept == served)
+                    continue;
+                next.changes++;
+                next.switched = true;
+            }
+            next.airlinesBegin = static_cast<int>(pool.size());
+            pool.insert(pool.end(), graph.airlinesBegin(e), graph.airlinesEnd(e));
+            next.airlinesEnd = static_cast<int>(pool.size());
+            push(next);
+        }
+    }
+
+    // Unwind each itinerary, flying every stretch without change with an airline common to the whole stretch
+    vector<ParetoItinerary> itineraries;
+    for (int index : front) {
+        ParetoItinerary itinerary;
+        itinerary.distance = labels[index].distance;
+        itinerary.changes = labels[index].changes;
+        AirlineId airline = pool[labels[index].airlinesBegin];
+        for (int i = index; i != -1; i = labels[i].parent) {
+            itinerary.airports.push_back(graph.getVertex(labels[i].vertex));
+            int parent = labels[i].parent;
+            if (parent == -1)
+                break;
+            itinerary.airlines.push_back(airline);
+            if (labels[i].switched)
+                airline = pool[labels[parent].airlinesBegin];
+        }
+        reverse(itinerary.airports.begin(), itinerary.airports.end());
+        reverse(itinerary.airlines.begin(), itinerary.airlines.end());
+        itineraries.push_back(move(itinerary));
+    }
+    return itineraries;
+}
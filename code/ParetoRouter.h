@@ -0,0 +1,87 @@
+/**
+ * @file ParetoRouter.h
+ * @brief Header file containing the multi-criteria itinerary search.
+ *
+ * The itinerary with the fewest flights is rarely the shortest one, and neither of them has to keep the same
+ * airline. The 'ParetoRouter' class finds, in a single search, every itinerary that no other itinerary beats on
+ * flights, distance and airline changes at once (the Pareto front). It is a label-setting search: a label is a
+ * partial itinerary ending at an airport, and a label dominated by one already settled at the same airport, or
+ * that cannot beat an itinerary already found, is dropped. The flights and distance left from each airport are
+ * bounded beforehand by backward searches from the targets, which ignore airlines, and labels are settled in
+ * lexicographic order of their costs plus those bounds, so the search heads for the targets like an A* search.
+ * A label keeps the set of airlines its last flight may have been flown with, so a flight route served by
+ * several airlines extends it once instead of once per airline.
+ */
+
+#ifndef AED_AIRPORTS_PARETOROUTER_H
+#define AED_AIRPORTS_PARETOROUTER_H
+
+#include "AirlineRouter.h"
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+
+/**
+ * @struct ParetoItinerary
+ * @brief An itinerary of the Pareto front: its airports, the airline of each flight and its costs.
+ */
+struct ParetoItinerary {
+    vector<Vertex<Airport>*> airports;  ///< The airports of the itinerary, from the source to the target.
+    vector<AirlineId> airlines;         ///< The airline of each flight, airlines[i] flying from airports[i] to airports[i + 1].
+    double distance = 0;    ///< The total distance of the itinerary in kilometers.
+    int changes = 0;        ///< The number of airline changes of the itinerary.
+};
+
+/**
+ * @class ParetoRouter
+ * @brief Searches the itineraries that are Pareto-optimal on flights, distance and airline changes.
+ */
+class ParetoRouter {
+private:
+    /**
+     * @struct Label
+     * @brief A partial itinerary of the search.
+     */
+    struct Label {
+        int state;              ///< The (airport, layovers visited) state the label ends at, or the sink for a complete itinerary.
+        int vertex;             ///< The vertex ID of the airport the label ends at.
+        int flights;            ///< The number of flights so far.
+        double distance;        ///< The distance flown so far, in kilometers.
+        int changes;            ///< The number of airline changes so far.
+        int parent;             ///< The label extended by the last flight, -1 for a starting airport.
+        bool switched;          ///< True if the last flight changed airline.
+        int airlinesBegin;      ///< The airlines of the last flight are in the pool at [airlinesBegin, airlinesEnd), -1 for any airline.
+        int airlinesEnd;        ///< The end of the airlines of the last flight in the pool.
+        int next;               ///< The next label settled at the same state, -1 for the last one.
+    };
+
+    const FrozenGraph& graph;       ///< The CSR snapshot of the airport graph.
+
+public:
+    static const int DEFAULT_MAX_LABELS = 32;   ///< The default number of labels settled per state.
+
+    /**
+     * @brief Constructor for the ParetoRouter class.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the router.
+     */
+    explicit ParetoRouter(const FrozenGraph& graph);
+
+    /**
+     * @brief Searches the Pareto front of the itineraries from any source airport to any target airport.
+     * @param sources The vertex IDs of the starting airports.
+     * @param targets The vertex IDs of the destination airports.
+     * @param layovers The vertex IDs of the airports the itineraries must go through, in order (may be empty).
+     * @param maxLabels The maximum number of labels settled per (airport, layovers visited) state. Labels are settled
+     * by increasing flights (counting the fewest flights left), so a small bound may miss itineraries with many more
+     * flights than necessary but never the fewest flights.
+     * @param context The search context holding the settled labels and the bounds of each state.
+     * @return One itinerary per point of the front, sorted by flights, then distance, then airline changes.
+     * Empty if no target is reachable.
+     *
+     * Time Complexity: O((L+1)*(V+E)*log(V)+N*log(N)) where L stands for the layovers, V for vertices, E for edges and
+     * N for the labels created, at most maxLabels*(L+1)*E*A with A for the airlines of each edge.
+     */
+    vector<ParetoItinerary> search(const vector<int>& sources, const vector<int>& targets, const vector<int>& layovers,
+                                   int maxLabels, SearchContext& context) const;
+};
+
+#endif //AED_AIRPORTS_PARETOROUTER_H
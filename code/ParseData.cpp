@@ -1,15 +1,88 @@
 #include "ParseData.h"
+#include "CsvReader.h"
+#include "Snapshot.h"
+#include <thread>
 
-ParseData::ParseData(const std::string& airportsCSV, const std::string& airlinesCSV, const std::string& flightsCSV) {
+ParseData::ParseData(const std::string& airportsCSV, const std::string& airlinesCSV, const std::string& flightsCSV, LoadMode mode, unsigned threads) {
     this->airportsCSV = airportsCSV;
     this->airlinesCSV = airlinesCSV;
     this->flightsCSV = flightsCSV;
-    parseAirlines();
-    parseAirports();
-    parseFlights();
+    this->threads = threads != 0 ? threads : max(1u, thread::hardware_concurrency());
+    parseCSV(mode);
+}
+
+ParseData::ParseData(const std::string& airportsCSV, const std::string& airlinesCSV, const std::string& flightsCSV, const std::string& snapshotFile, LoadMode mode, unsigned threads) {
+    this->airportsCSV = airportsCSV;
+    this->airlinesCSV = airlinesCSV;
+    this->flightsCSV = flightsCSV;
+    this->threads = threads != 0 ? threads : max(1u, thread::hardware_concurrency());
+
+    if (IsSnapshotFresh(snapshotFile, {airportsCSV, airlinesCSV, flightsCSV}) && ReadSnapshot(snapshotFile, dataGraph, airlineRegistry, hierarchy)) {
+        fromSnapshot = true;
+        hierarchyStored = !hierarchy.empty();
+        dataGraph.setupInDegreeAndOutDegree();
+        return;
+    }
+
+    parseCSV(mode);
+    if (!WriteSnapshot(snapshotFile, dataGraph, airlineRegistry, hierarchy))
+        cerr << "Warning: Unable to write snapshot " << snapshotFile << endl;
+}
+
+bool ParseData::buildContractionHierarchy(const std::string& snapshotFile) {
+    if (!hierarchy.empty())
+        return hierarchyStored;
+    hierarchy = ContractionHierarchy(FrozenGraph(dataGraph), SearchContext::local());
+    hierarchyStored = WriteSnapshot(snapshotFile, dataGraph, airlineRegistry, hierarchy);
+    return hierarchyStored;
+}
+
+void ParseData::parseCSV(LoadMode mode) {
+    if (mode == LoadMode::STREAM) {
+        parseAirlines();
+        parseAirports();
+        parseFlights();
+    } else {
+        parseAirlinesMapped();
+        parseAirportsMapped();
+        if (mode == LoadMode::PARALLEL && this->threads > 1) parseFlightsParallel();
+        else parseFlightsMapped();
+    }
     dataGraph.setupInDegreeAndOutDegree();
 }
 
+// Splits a line of the stream loader into trimmed fields, viewed the same way as the rows of the mapped loaders
+static const vector<string_view>& SplitLine(const string& line, vector<string>& row, vector<string_view>& fields) {
+    stringstream ss(line);
+    string nonTrimmed;
+    row.clear();
+    while (getline(ss, nonTrimmed, ','))
+        row.push_back(TrimString(nonTrimmed));
+    fields.assign(row.begin(), row.end());
+    return fields;
+}
+
+bool ParseData::parseAirlineRow(const vector<string_view>& fields, Airline& airline) {
+    if (fields.size() < 4) return false;
+    airline = Airline(string(fields[0]), string(fields[1]), string(fields[2]), string(fields[3]));
+    return true;
+}
+
+bool ParseData::parseAirportRow(const vector<string_view>& fields, Airport& airport) {
+    Coordinates location{};
+    if (fields.size() < 6 || !ParseDouble(fields[4], location.latitude) || !ParseDouble(fields[5], location.longitude)) return false;
+    airport = Airport(string(fields[0]), string(fields[1]), string(fields[2]), string(fields[3]), location);
+    return true;
+}
+
+bool ParseData::resolveFlightRow(const vector<string_view>& fields, Vertex<Airport>*& sourceAirport, Vertex<Airport>*& targetAirport) const {
+    if (fields.size() < 3) return false;
+    // Airport and airline codes fit in the small string buffer, so these lookups do not allocate
+    sourceAirport = dataGraph.findVertexByKey(string(fields[0]));
+    targetAirport = dataGraph.findVertexByKey(string(fields[1]));
+    return sourceAirport != nullptr && targetAirport != nullptr;
+}
+
 void ParseData::parseAirlines() {
     ifstream file(airlinesCSV);
     if (!file.is_open()) {
@@ -19,28 +92,20 @@ void ParseData::parseAirlines() {
 
     string line;
     getline(file, line);
+    set<Airline> airlinesInfo;
 
-    while(getline(file, line)){
-        stringstream ss(line);
-
-        string nonTrimmed;
+    vector<string> row;
+    vector<string_view> fields;
+    while (getline(file, line)) {
         Airline airlineObj;
-
-        getline(ss, nonTrimmed, ',');
-        airlineObj.setCode(TrimString(nonTrimmed));
-
-        getline(ss, nonTrimmed, ',');
-        airlineObj.setName(TrimString(nonTrimmed));
-
-        getline(ss, nonTrimmed, ',');
-        airlineObj.setCallsign(TrimString(nonTrimmed));
-
-        getline(ss, nonTrimmed, ',');
-        airlineObj.setCountry(TrimString(nonTrimmed));
-
-        airlinesInfo.insert(airlineObj);
+        if (parseAirlineRow(SplitLine(line, row, fields), airlineObj))
+            airlinesInfo.insert(airlineObj);
     }
     file.close();
+
+    // Registering the airlines by code order keeps the sorted airline IDs of each flight route in code order
+    for (const auto& airline : airlinesInfo)
+        airlineRegistry.addAirline(airline);
 }
 
 void ParseData::parseAirports() {
@@ -53,31 +118,12 @@ void ParseData::parseAirports() {
     string line;
     getline(file, line);
 
+    vector<string> row;
+    vector<string_view> fields;
     while (getline(file, line)) {
-        stringstream ss(line);
-
-        string nonTrimmed;
         Airport airportObj;
-        double latitude, longitude;
-
-        getline(ss, nonTrimmed, ',');
-        airportObj.setCode(TrimString(nonTrimmed));
-
-        getline(ss, nonTrimmed, ',');
-        airportObj.setName(TrimString(nonTrimmed));
-
-        getline(ss, nonTrimmed, ',');
-        airportObj.setCity(TrimString(nonTrimmed));
-
-        getline(ss, nonTrimmed, ',');
-        airportObj.setCountry(TrimString(nonTrimmed));
-
-        ss >> latitude;
-        ss.ignore();
-        ss >> longitude;
-        airportObj.setLocation(latitude, longitude);
-
-        dataGraph.addVertex(airportObj);
+        if (parseAirportRow(SplitLine(line, row, fields), airportObj))
+            dataGraph.addVertex(airportObj);
     }
     file.close();
 }
@@ -91,63 +137,176 @@ void ParseData::parseFlights() {
 
     string line;
     getline(file, line);
-    Airport temp1, temp2 = *new Airport();
 
-    while(getline(file, line)) {
-        stringstream ss(line);
+    vector<string> row;
+    vector<string_view> fields;
+    while (getline(file, line)) {
+        Vertex<Airport>* sourceAirport;
+        Vertex<Airport>* targetAirport;
+        if (resolveFlightRow(SplitLine(line, row, fields), sourceAirport, targetAirport))
+            addFlight(sourceAirport, targetAirport, row[2]);
+    }
+    file.close();
+}
 
-        string source, target, airlineCode;
+void ParseData::addFlight(Vertex<Airport>* sourceAirport, Vertex<Airport>* targetAirport, const std::string& airlineCode) {
+    Edge<Airport>* foundEdge = dataGraph.findEdge(sourceAirport, targetAirport);
+    if (!foundEdge) {
+        double distance = sourceAirport->getInfo().getDistance(targetAirport->getInfo().getLocation());
+        foundEdge = &dataGraph.addEdge(sourceAirport, targetAirport, distance);
+    }
+
+    AirlineId airlineId;
+    if (airlineRegistry.findAirlineId(airlineCode, airlineId))
+        foundEdge->addAirline(airlineId);
 
-        getline(ss, source, ',');
-        source = TrimString(source);
+    sourceAirport->setFlightsFrom(sourceAirport->getFlightsFrom() + 1);
+    targetAirport->setFlightsTo(targetAirport->getFlightsTo() + 1);
+}
 
-        getline(ss, target, ',');
-        target = TrimString(target);
+void ParseData::parseAirlinesMapped() {
+    MappedFile file(airlinesCSV);
+    if (!file.isOpen()) {
+        cerr << "Error: Unable to open file " << airlinesCSV << endl;
+        return;
+    }
 
-        getline(ss, airlineCode, ',');
-        airlineCode = TrimString(airlineCode);
+    CsvReader reader(file.view());
+    reader.skipLine();
+    vector<string_view> fields;
+    set<Airline> airlinesInfo;
 
-        temp1.setCode(source);
-        temp2.setCode(target);
+    while (reader.nextRow(fields)) {
+        Airline airline;
+        if (parseAirlineRow(fields, airline))
+            airlinesInfo.insert(airline);
+    }
 
-        Vertex<Airport>* sourceAirport = dataGraph.findVertex(temp1);
-        Vertex<Airport>* targetAirport = dataGraph.findVertex(temp2);
+    for (const auto& airline : airlinesInfo)
+        airlineRegistry.addAirline(airline);
+}
 
-        Edge<Airport>* foundEdge = nullptr;
-        for (auto& e : sourceAirport->getAdj()) {
-            auto t = e.getDest();
-            if (t->getInfo() == targetAirport->getInfo()) {
-                foundEdge = const_cast<Edge<Airport>*>(&e);
-                break;
-            }
-        }
+void ParseData::parseAirportsMapped() {
+    MappedFile file(airportsCSV);
+    if (!file.isOpen()) {
+        cerr << "Error: Unable to open file " << airportsCSV << endl;
+        return;
+    }
+
+    CsvReader reader(file.view());
+    reader.skipLine();
+    vector<string_view> fields;
+
+    while (reader.nextRow(fields)) {
+        Airport airport;
+        if (parseAirportRow(fields, airport))
+            dataGraph.addVertex(airport);
+    }
+}
+
+void ParseData::parseFlightsMapped() {
+    MappedFile file(flightsCSV);
+    if (!file.isOpen()) {
+        cerr << "Error: Unable to open file " << flightsCSV << endl;
+        return;
+    }
 
-        if (foundEdge) {
-            foundEdge->addAirline(getAirline(airlineCode));
-        } else {
-            double distance = sourceAirport->getInfo().getDistance(targetAirport->getInfo().getLocation());
-            dataGraph.addEdge(sourceAirport->getInfo(), targetAirport->getInfo(), distance);
-
-            for (auto& e : sourceAirport->getAdj()) {
-                auto t = e.getDest();
-                if (t->getInfo() == targetAirport->getInfo()) {
-                    auto& nonConstEdge = const_cast<Edge<Airport>&>(e);
-                    nonConstEdge.addAirline(getAirline(airlineCode));
-                    break;
-                }
-            }
+    CsvReader reader(file.view());
+    reader.skipLine();
+    vector<string_view> fields;
+
+    while (reader.nextRow(fields)) {
+        Vertex<Airport>* sourceAirport;
+        Vertex<Airport>* targetAirport;
+        if (resolveFlightRow(fields, sourceAirport, targetAirport))
+            addFlight(sourceAirport, targetAirport, string(fields[2]));
+    }
+}
+
+void ParseData::parseFlightsParallel() {
+    MappedFile file(flightsCSV);
+    if (!file.isOpen()) {
+        cerr << "Error: Unable to open file " << flightsCSV << endl;
+        return;
+    }
+
+    string_view text = file.view();
+    size_t headerEnd = text.find('\n');
+    text = (headerEnd == string_view::npos) ? string_view() : text.substr(headerEnd + 1);
+
+    // Split the rows into one byte range per thread, moving each boundary to the next line start
+    vector<size_t> bounds = {0};
+    for (unsigned t = 1; t < threads; t++) {
+        size_t bound = max(bounds.back(), text.size() * t / threads);
+        size_t lineEnd = text.find('\n', bound == 0 ? 0 : bound - 1);
+        bounds.push_back(lineEnd == string_view::npos ? text.size() : lineEnd + 1);
+    }
+    bounds.push_back(text.size());
+
+    vector<vector<FlightRow>> chunks(threads);
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([this, &chunks, &bounds, text, t]() {
+            resolveFlightRows(text.substr(bounds[t], bounds[t + 1] - bounds[t]), chunks[t]);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    vector<FlightRow> rows;
+    for (auto& chunk : chunks) {
+        for (auto& row : chunk) {
+            row.order = static_cast<int>(rows.size());
+            rows.push_back(row);
         }
+        vector<FlightRow>().swap(chunk);
+    }
 
-        sourceAirport->setFlightsFrom(sourceAirport->getFlightsFrom() + 1);
-        targetAirport->setFlightsTo(targetAirport->getFlightsTo() + 1);
+    auto vertices = dataGraph.getVertexSet();
+    for (const auto& row : rows) {
+        vertices[row.source]->setFlightsFrom(vertices[row.source]->getFlightsFrom() + 1);
+        vertices[row.target]->setFlightsTo(vertices[row.target]->getFlightsTo() + 1);
+    }
 
+    // Group the rows by flight route, each route being created where its first flight appears in the file
+    sort(rows.begin(), rows.end(), [](const FlightRow& a, const FlightRow& b) {
+        if (a.source != b.source) return a.source < b.source;
+        if (a.target != b.target) return a.target < b.target;
+        return a.order < b.order;
+    });
+
+    vector<pair<size_t, size_t>> routes;    // Range of rows of each flight route
+    for (size_t begin = 0, end; begin < rows.size(); begin = end) {
+        for (end = begin + 1; end < rows.size() && rows[end].source == rows[begin].source && rows[end].target == rows[begin].target; end++);
+        routes.emplace_back(begin, end);
+    }
+    stable_sort(routes.begin(), routes.end(), [&rows](const pair<size_t, size_t>& a, const pair<size_t, size_t>& b) {
+        if (rows[a.first].source != rows[b.first].source) return rows[a.first].source < rows[b.first].source;
+        return rows[a.first].order < rows[b.first].order;
+    });
+
+    for (const auto& route : routes) {
+        auto sourceAirport = vertices[rows[route.first].source];
+        auto targetAirport = vertices[rows[route.first].target];
+        double distance = sourceAirport->getInfo().getDistance(targetAirport->getInfo().getLocation());
+        auto& edge = dataGraph.addEdge(sourceAirport, targetAirport, distance);
+        for (size_t r = route.first; r < route.second; r++) {
+            if (rows[r].airline != -1)
+                edge.addAirline(static_cast<AirlineId>(rows[r].airline));
+        }
     }
-    file.close();
 }
 
-Airline ParseData::getAirline(const std::string& airlineCode) {
-    for (const auto & it : airlinesInfo) {
-        if (it.getCode() == airlineCode) return it;
+void ParseData::resolveFlightRows(string_view text, vector<FlightRow>& rows) const {
+    CsvReader reader(text);
+    vector<string_view> fields;
+
+    while (reader.nextRow(fields)) {
+        Vertex<Airport>* sourceAirport;
+        Vertex<Airport>* targetAirport;
+        if (!resolveFlightRow(fields, sourceAirport, targetAirport)) continue;
+
+        AirlineId airlineId;
+        int airline = airlineRegistry.findAirlineId(string(fields[2]), airlineId) ? airlineId : -1;
+        rows.push_back({sourceAirport->getId(), targetAirport->getId(), airline, 0});
     }
-    return {};
-}
\ No newline at end of file
+}
@@ -11,20 +11,54 @@
 #define AED_AIRPORTS_PARSEDATA_H
 
 #include "Data.h"
+#include "ContractionHierarchy.h"
 #include "Graph.h"
 #include <fstream>
+#include <string_view>
 
 /**
  * @class ParseData
  * @brief Class responsible for parsing data from CSV files
  */
 class ParseData {
+public:
+    /**
+     * @enum LoadMode
+     * @brief Strategy used to read the CSV files.
+     */
+    enum class LoadMode {
+        STREAM,     ///< Reads line by line, splitting each line with a string stream.
+        MAPPED,     ///< Maps each file into memory and tokenizes it in place with string views.
+        PARALLEL    ///< Like MAPPED, but the flights file is split into line-aligned byte ranges parsed by worker threads.
+    };
+
 private:
+    /**
+     * @struct FlightRow
+     * @brief A flight row resolved to airport and airline IDs by the parallel loader.
+     */
+    struct FlightRow {
+        int source;     ///< ID of the source airport.
+        int target;     ///< ID of the target airport.
+        int airline;    ///< ID of the airline, or -1 if the airline is not registered.
+        int order;      ///< Position of the row in the file.
+    };
+
     Graph<Airport> dataGraph;          ///< Graph structure representing the relationships between airports and airlines.
-    std::set<Airline> airlinesInfo;    ///< Set containing the airlines information.
+    AirlineRegistry airlineRegistry;   ///< Registry assigning a dense ID to each airline.
+    ContractionHierarchy hierarchy;    ///< Contraction hierarchy of the flight route distances, empty until it is built.
     std::string airportsCSV;           ///< The file path to the CSV containing airports data to be parse.
     std::string airlinesCSV;           ///< The file path to the CSV containing airlines data to be parse.
     std::string flightsCSV;            ///< The file path to the CSV containing flights data to be parse.
+    unsigned threads;                  ///< Number of worker threads used by the parallel loader.
+    bool fromSnapshot = false;         ///< Indicates if the data was loaded from a binary snapshot.
+    bool hierarchyStored = false;      ///< Indicates if the snapshot holds the contraction hierarchy.
+
+    /**
+     * @brief Parses the three CSV files and builds the graph.
+     * @param mode Strategy used to read the CSV files.
+     */
+    void parseCSV(LoadMode mode);
 
     /**
     * @brief Parses information about airlines from the airlines CSV file.
@@ -42,11 +76,68 @@ private:
     void parseFlights();
 
     /**
-     * @brief Retrieves information about a specific airline using its code.
-     * @param airlineCode The code of the airline to retrieve information for.
-     * @return Information about the airline with the specified code.
+     * @brief Parses information about airlines from the memory-mapped airlines CSV file.
+     */
+    void parseAirlinesMapped();
+
+    /**
+     * @brief Parses information about airports from the memory-mapped airports CSV file.
+     */
+    void parseAirportsMapped();
+
+    /**
+     * @brief Parses information about flights from the memory-mapped flights CSV file.
+     */
+    void parseFlightsMapped();
+
+    /**
+     * @brief Parses information about flights from the memory-mapped flights CSV file using several threads.
+     *
+     * Each thread resolves the rows of a line-aligned byte range to airport and airline IDs. The rows are then
+     * sorted by flight route, deduplicated and added to the graph in the order of their first appearance in the
+     * file, so the result is the same as the one of the sequential loaders, whatever the number of threads.
+     */
+    void parseFlightsParallel();
+
+    /**
+     * @brief Resolves the flight rows of a range of the flights CSV text to IDs.
+     * @param text The CSV text of the range, made of whole lines.
+     * @param rows [out] Vector where the resolved rows are appended.
+     */
+    void resolveFlightRows(std::string_view text, std::vector<FlightRow>& rows) const;
+
+    /**
+     * @brief Builds an airline from the fields of a row of the airlines CSV file, the same way in every load mode.
+     * @param fields The trimmed fields of the row.
+     * @param airline [out] The parsed airline.
+     * @return True if the row has every field, otherwise false (the row is skipped).
      */
-    Airline getAirline(const std::string& airlineCode);
+    static bool parseAirlineRow(const std::vector<std::string_view>& fields, Airline& airline);
+
+    /**
+     * @brief Builds an airport from the fields of a row of the airports CSV file, the same way in every load mode.
+     * @param fields The trimmed fields of the row.
+     * @param airport [out] The parsed airport.
+     * @return True if the row has every field and valid coordinates, otherwise false (the row is skipped).
+     */
+    static bool parseAirportRow(const std::vector<std::string_view>& fields, Airport& airport);
+
+    /**
+     * @brief Resolves the airports of a row of the flights CSV file, the same way in every load mode.
+     * @param fields The trimmed fields of the row.
+     * @param sourceAirport [out] Pointer to the source airport vertex.
+     * @param targetAirport [out] Pointer to the target airport vertex.
+     * @return True if the row has every field and both airports exist, otherwise false (the row is skipped).
+     */
+    bool resolveFlightRow(const std::vector<std::string_view>& fields, Vertex<Airport>*& sourceAirport, Vertex<Airport>*& targetAirport) const;
+
+    /**
+     * @brief Adds a flight to the graph, creating its flight route if needed and updating the flight counters.
+     * @param sourceAirport Pointer to the source airport vertex.
+     * @param targetAirport Pointer to the target airport vertex.
+     * @param airlineCode The code of the airline operating the flight.
+     */
+    void addFlight(Vertex<Airport>* sourceAirport, Vertex<Airport>* targetAirport, const std::string& airlineCode);
 
 public:
     /**
@@ -54,8 +145,24 @@ public:
      * @param airportsCSV Path to the airports CSV file.
      * @param airlinesCSV Path to the airlines CSV file.
      * @param flightsCSV Path to the flights CSV file.
+     * @param mode Strategy used to read the CSV files.
+     * @param threads Number of worker threads of the PARALLEL mode (0 uses every hardware thread, 1 falls back to MAPPED).
+     */
+    ParseData(const std::string& airportsCSV, const std::string& airlinesCSV, const std::string& flightsCSV, LoadMode mode = LoadMode::PARALLEL, unsigned threads = 0);
+
+    /**
+     * @brief Constructor for ParseData class that goes through a binary snapshot of the data (see Snapshot.h).
+     *
+     * The snapshot is loaded if it is valid and newer than the three CSV files. Otherwise the CSV files are
+     * parsed and the snapshot is rewritten for the next launches.
+     * @param airportsCSV Path to the airports CSV file.
+     * @param airlinesCSV Path to the airlines CSV file.
+     * @param flightsCSV Path to the flights CSV file.
+     * @param snapshotFile Path to the snapshot file.
+     * @param mode Strategy used to read the CSV files if the snapshot cannot be used.
+     * @param threads Number of worker threads of the PARALLEL mode (0 uses every hardware thread, 1 falls back to MAPPED).
      */
-    ParseData(const std::string& airportsCSV, const std::string& airlinesCSV, const std::string& flightsCSV);
+    ParseData(const std::string& airportsCSV, const std::string& airlinesCSV, const std::string& flightsCSV, const std::string& snapshotFile, LoadMode mode = LoadMode::PARALLEL, unsigned threads = 0);
 
     /**
      * @brief Retrieves the constructed airport graph.
@@ -64,10 +171,35 @@ public:
     const Graph<Airport>& getDataGraph() const { return dataGraph; }
 
     /**
-     * @brief Retrieves the airlines information set.
-     * @return A constant reference to the airlines information set.
+     * @brief Retrieves the airlines registry.
+     * @return A constant reference to the registry with the airlines information.
+     */
+    const AirlineRegistry& getAirlineRegistry() const { return airlineRegistry; }
+
+    /**
+     * @brief Checks if the data was loaded from a binary snapshot instead of the CSV files.
+     * @return True if the snapshot was used, otherwise false.
+     */
+    bool isFromSnapshot() const { return fromSnapshot; }
+
+    /**
+     * @brief Retrieves the contraction hierarchy of the flight route distances.
+     * @return A constant reference to the hierarchy, empty if it was neither loaded from the snapshot nor built.
+     */
+    const ContractionHierarchy& getContractionHierarchy() const { return hierarchy; }
+
+    /**
+     * @brief Builds the contraction hierarchy if the snapshot did not hold one, and stores it in the snapshot.
+     *
+     * Building the hierarchy takes seconds on the full data set, so it is optional and only built when first
+     * needed: once it is stored, the next launches load it with the snapshot instead. The snapshot is only written
+     * when a new hierarchy is built.
+     * @param snapshotFile Path to the snapshot file.
+     * @return True if the snapshot holds the hierarchy, otherwise false (the hierarchy can still be used).
+     *
+     * Time Complexity: see ContractionHierarchy.
      */
-    const std::set<Airline>& getAirlinesInfo() const { return airlinesInfo; }
+    bool buildContractionHierarchy(const std::string& snapshotFile);
 };
 
 
@@ -0,0 +1,62 @@
+#include "QueryEngine.h"
+
+QueryEngine::QueryEngine(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry, unsigned threads) : consult(dataGraph, airlineRegistry) {
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    for (unsigned t = 0; t < threads; t++)
+        workers.emplace_back(&QueryEngine::work, this);
+}
+
+QueryEngine::~QueryEngine() {
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        stopping = true;
+    }
+    tasksAvailable.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void QueryEngine::work() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(tasksMutex);
+            tasksAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+vector<future<vector<vector<Vertex<Airport>*>>>> QueryEngine::submitRoutes(const vector<pair<Vertex<Airport>*, Vertex<Airport>*>>& routes) {
+    vector<function<vector<vector<Vertex<Airport>*>>(Consult&)>> queries;
+    for (const auto& route : routes) {
+        queries.push_back([route](Consult& c) { return c.searchSmallestPathBetweenAirports(route.first, route.second); });
+    }
+    return submitBatch(queries);
+}
+
+vector<future<int>> QueryEngine::submitReachability(const vector<pair<Vertex<Airport>*, int>>& queries) {
+    vector<function<int(Consult&)>> batch;
+    for (const auto& query : queries) {
+        batch.push_back([query](Consult& c) { return c.searchNumberOfReachableAirportsInXStopsFromAirport(query.first, query.second); });
+    }
+    return submitBatch(batch);
+}
+
+vector<future<AirportStatistics>> QueryEngine::submitStatistics(const vector<Vertex<Airport>*>& airports) {
+    vector<function<AirportStatistics(Consult&)>> queries;
+    for (auto airport : airports) {
+        queries.push_back([airport](Consult& c) {
+            return AirportStatistics{c.searchNumberOfFlightsOutOfAirport(airport), c.searchNumberOfFlightsToAirport(airport),
+                                     c.searchNumberOfFlightsOutOfAirportFromDifferentAirlines(airport),
+                                     c.searchNumberOfCountriesFlownToFromAirport(airport),
+                                     c.searchNumberOfAirportsAvailableForAirport(airport)};
+        });
+    }
+    return submitBatch(queries);
+}
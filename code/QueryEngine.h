@@ -0,0 +1,166 @@
+/**
+ * @file QueryEngine.h
+ * @brief Header file containing the concurrent query engine.
+ *
+ * This file defines the 'QueryEngine' class, which runs queries of the 'Consult' class on a pool of worker threads.
+ * All workers share one Consult over the same immutable graph: queries only read the graph and keep their
+ * traversal state in the SearchContext of their thread, so they run without any lock. The only synchronization
+ * is the hand-off of the queued queries to the workers.
+ */
+
+#ifndef AED_AIRPORTS_QUERYENGINE_H
+#define AED_AIRPORTS_QUERYENGINE_H
+
+#include "Consult.h"
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @struct AirportStatistics
+ * @brief Flight statistics of an airport, computed by a single query.
+ */
+struct AirportStatistics {
+    int flightsOut;             ///< The number of flights out of the airport.
+    int flightsIn;              ///< The number of flights to the airport.
+    int airlines;               ///< The number of different airlines flying out of the airport.
+    int destinationCountries;   ///< The number of countries flown to directly from the airport.
+    int reachableAirports;      ///< The number of airports reachable from the airport with any number of stops.
+};
+
+/**
+ * @class QueryEngine
+ * @brief Thread pool answering queries on a shared, immutable airport graph.
+ *
+ * Queries are submitted one by one or in batches and their results are returned as futures. The graph and the
+ * airline registry must not be modified while the engine exists.
+ */
+class QueryEngine {
+private:
+    Consult consult;                        ///< The consult shared by every worker.
+    vector<thread> workers;                 ///< The worker threads.
+    queue<function<void()>> tasks;          ///< The queries waiting for a worker.
+    mutex tasksMutex;                       ///< Protects the task queue and the stopping flag.
+    condition_variable tasksAvailable;      ///< Signals the workers that tasks were queued or that the engine stops.
+    bool stopping = false;                  ///< Indicates if the engine is being destroyed.
+
+    /**
+     * @brief Main loop of a worker thread, runs queued tasks until the engine stops and the queue is empty.
+     */
+    void work();
+
+    /**
+     * @brief Wraps a query into a task and its future, without queueing it.
+     * @param query Function taking the shared Consult and returning the result of the query.
+     * @param task [out] The task running the query.
+     * @return The future result of the query.
+     */
+    template <typename Query>
+    auto makeTask(Query query, function<void()>& task) -> future<decltype(query(declval<Consult&>()))>;
+
+public:
+    /**
+     * @brief Constructor for the QueryEngine class, starts the worker threads.
+     * @param dataGraph The airport graph queried by the engine.
+     * @param airlineRegistry The registry with the airlines of the graph.
+     * @param threads The number of worker threads (0 uses every hardware thread).
+     */
+    QueryEngine(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry, unsigned threads = 0);
+
+    /**
+     * @brief Destructor for the QueryEngine class, finishes the queued queries and joins the worker threads.
+     */
+    ~QueryEngine();
+
+    QueryEngine(const QueryEngine&) = delete;
+    QueryEngine& operator=(const QueryEngine&) = delete;
+
+    /**
+     * @brief Retrieves the number of worker threads.
+     * @return The number of worker threads.
+     */
+    unsigned getNumThreads() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * @brief Retrieves the consult shared by the workers, to look up airports without a second copy of the graph.
+     * @return A constant reference to the consult.
+     */
+    const Consult& getConsult() const { return consult; }
+
+    /**
+     * @brief Submits a query.
+     * @param query Function taking the shared Consult and returning the result of the query. It must only call
+     * the query methods of the Consult, which are safe to run concurrently.
+     * @return The future result of the query.
+     */
+    template <typename Query>
+    auto submit(Query query) -> future<decltype(query(declval<Consult&>()))>;
+
+    /**
+     * @brief Submits a batch of queries, queued at once.
+     * @param queries The queries, as accepted by submit().
+     * @return The future result of each query, in the same order.
+     */
+    template <typename Query>
+    auto submitBatch(const vector<Query>& queries) -> vector<future<decltype(declval<Query&>()(declval<Consult&>()))>>;
+
+    /**
+     * @brief Submits a batch of route queries, searching the smallest paths between pairs of airports.
+     * @param routes The source and target airports of each query.
+     * @return The future smallest paths of each query (see Consult::searchSmallestPathBetweenAirports).
+     */
+    vector<future<vector<vector<Vertex<Airport>*>>>> submitRoutes(const vector<pair<Vertex<Airport>*, Vertex<Airport>*>>& routes);
+
+    /**
+     * @brief Submits a batch of reachability queries, counting the airports reachable within a number of stops.
+     * @param queries The source airport and the maximum number of layovers of each query.
+     * @return The future number of reachable airports of each query.
+     */
+    vector<future<int>> submitReachability(const vector<pair<Vertex<Airport>*, int>>& queries);
+
+    /**
+     * @brief Submits a batch of statistics queries.
+     * @param airports The airports whose statistics are computed.
+     * @return The future statistics of each airport.
+     */
+    vector<future<AirportStatistics>> submitStatistics(const vector<Vertex<Airport>*>& airports);
+};
+
+template <typename Query>
+auto QueryEngine::makeTask(Query query, function<void()>& task) -> future<decltype(query(declval<Consult&>()))> {
+    using Result = decltype(query(declval<Consult&>()));
+    auto packaged = make_shared<packaged_task<Result()>>([this, query]() mutable { return query(consult); });
+    task = [packaged]() { (*packaged)(); };
+    return packaged->get_future();
+}
+
+template <typename Query>
+auto QueryEngine::submit(Query query) -> future<decltype(query(declval<Consult&>()))> {
+    function<void()> task;
+    auto result = makeTask(query, task);
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        tasks.push(move(task));
+    }
+    tasksAvailable.notify_one();
+    return result;
+}
+
+template <typename Query>
+auto QueryEngine::submitBatch(const vector<Query>& queries) -> vector<future<decltype(declval<Query&>()(declval<Consult&>()))>> {
+    vector<future<decltype(declval<Query&>()(declval<Consult&>()))>> results;
+    vector<function<void()>> batch(queries.size());
+    for (size_t i = 0; i < queries.size(); i++)
+        results.push_back(makeTask(queries[i], batch[i]));
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        for (auto& task : batch)
+            tasks.push(move(task));
+    }
+    tasksAvailable.notify_all();
+    return results;
+}
+
+#endif //AED_AIRPORTS_QUERYENGINE_H
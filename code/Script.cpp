@@ -1,6 +1,6 @@
 #include "Script.h"
 
-Script::Script(const Graph<Airport>& dataGraph, const set<Airline> airlinesInfo) : dataGraph(dataGraph), consult(dataGraph, airlinesInfo) {}
+Script::Script(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry, function<const ContractionHierarchy*()> hierarchySource) : dataGraph(dataGraph), consult(dataGraph, airlineRegistry, move(hierarchySource)) {}
 
 void Script::drawBox(const string &text) {
     int width = text.length() + 4;
@@ -116,7 +116,7 @@ void Script::run() {
         } else if (mainChoice == 3) {
             clearScreen();
             drawBox("Export data as text file");
-            convertDataGraphToTextFile(dataGraph, "output/global_data.txt");
+            convertDataGraphToTextFile(dataGraph, consult.getAirlineRegistry(), "output/global_data.txt");
             backToMenu();
         }
     }
@@ -428,6 +428,7 @@ void Script::globalNumber() {
             {makeBold("Number of flights per airline"), &Script::flightsPerAirline},
             {makeBold("Number of different countries that a given city flies to"), &Script::countriesFlownToFromCity},
             {makeBold("Maximum trip"), &Script::maximumTrip},
+            {makeBold("Eccentricity of the airports"), &Script::airportEccentricities},
             {makeBold("Top airports with greatest air traffic capacity"), &Script::topKAirportAirTraffic},
             {makeBold("Essential airports"), &Script::essentialAirports},
             {"[Back]", &Script::actionGoBack}
@@ -450,7 +451,7 @@ void Script::globalNumber() {
             continue;
         }
         clearScreen();
-        if (choice == 10) {
+        if (choice == 11) {
             exitSubMenu = true;
         } else if (choice >= 1 && choice <= globalStatistics.size()) {
             (this->*globalStatistics[choice - 1].action)();
@@ -509,9 +510,6 @@ void Script::countriesFlownToFromCity() {
 }
 
 void Script::maximumTrip() {
-    cout << "Processing..." << endl;
-    cout << "Please wait a few seconds..." << endl;
-
     int diameter;
     auto airportPaths = consult.searchMaxTripAndCorrespondingPairsOfAirports(diameter);
     drawBox("Maximum Trip");
@@ -530,6 +528,28 @@ void Script::maximumTrip() {
     backToMenu();
 }
 
+void Script::airportEccentricities() {
+    auto airports = consult.searchAirportsByEccentricity();
+    drawBox("Eccentricity of the airports");
+    for (const auto& group : airports) {
+        cout << "Eccentricity " << makeBold(group.first) << ": " << group.second.size() << " airport(s)";
+        if (group.first == 0) cout << " without departing flights";
+        cout << endl;
+    }
+
+    // Airports without departing flights trivially have the smallest eccentricity, so they are left out
+    auto center = airports.upper_bound(0);
+    if (center != airports.end()) {
+        cout << "\nAirports with the smallest eccentricity (" << makeBold(center->first) << "):" << endl;
+        int index = 1;
+        for (auto airport : center->second) {
+            cout << index++ << ". ";
+            printAirportInfoOneline(airport->getInfo());
+        }
+    }
+    backToMenu();
+}
+
 void Script::topKAirportAirTraffic() {
     cout << "Enter the desired number of airports to display: ";
     int k;
@@ -551,12 +571,21 @@ void Script::topKAirportAirTraffic() {
 
 void Script::essentialAirports() {
     clearScreen();
-    auto airports = consult.searchEssentialAirports();
+    auto biconnectivity = consult.searchBiconnectivity();
+    const auto& airports = biconnectivity.getArticulationPoints();
     cout << "There are " << makeBold(airports.size()) << " essential airports to the network's circulation capacity" << endl;
     int index = 1;
-    for (const auto& airport : airports) {
-        cout << index++ << ". " << airport << endl;
+    for (int airport : airports) {
+        cout << index++ << ". ";
+        printAirportInfoOneline(consult.getAirport(airport)->getInfo());
     }
+
+    size_t largest = 0;
+    for (const auto& component : biconnectivity.getComponents())
+        largest = max(largest, component.size());
+    cout << "\nThere are " << makeBold(biconnectivity.getBridges().size()) << " flight routes whose removal disconnects the network" << endl;
+    cout << "The network splits into " << makeBold(biconnectivity.getComponents().size())
+         << " groups of airports that no single airport separates, the largest with " << makeBold(largest) << " airports" << endl;
     backToMenu();
 }
 
@@ -731,9 +760,15 @@ void Script::extraFiltersTravel() {
             cout << "0. Clear custom layovers list" << endl;
         }
 
+        // Ordering the custom layovers is only offered with two or more of them, before [Back]
+        bool canOrderLayovers = customLayoversChosen && customLayovers.size() > 1;
+        int backChoice = canOrderLayovers ? 4 : 3;
         cout << "1. Show best flights" << endl;
         cout << "2. Add custom layovers" << endl;
-        cout << "3. [Back]" << endl;
+        if (canOrderLayovers) {
+            cout << "3. Visit custom layovers in the best order" << endl;
+        }
+        cout << backChoice << ". [Back]" << endl;
         cout << makeBold("\nNote: ") <<"option 2 is to add specific layover airports that your flight must pass through" << endl;
 
         int choice;
@@ -745,7 +780,7 @@ void Script::extraFiltersTravel() {
         }
         clearScreen();
 
-        if (choice == 3) {
+        if (choice == backChoice) {
             customLayoversChosen = false;
             return;
         }
@@ -763,6 +798,8 @@ void Script::extraFiltersTravel() {
                 customLayoversChosen = true;
             }
             selectCustomLayovers();
+        } else if (choice == 3 && canOrderLayovers) {
+            orderCustomLayovers();
         }
     }
 }
@@ -799,6 +836,57 @@ void Script::selectCustomLayovers() {
     }
 }
 
+void Script::orderCustomLayovers() {
+    while (true) {
+        clearScreen();
+        drawBox("Order Custom Layovers");
+        printCustomLayovers();
+
+        cout << "1. Fewest flights" << endl;
+        cout << "2. Shortest distance" << endl;
+        cout << "3. [Back]" << endl;
+        int choice;
+        cout << "\nEnter your choice: ";
+        if (!(cin >> choice)) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            continue;
+        }
+        clearScreen();
+
+        if (choice == 3) {
+            return;
+        }
+        if (choice < 1 || choice > 2) {
+            continue;
+        }
+
+        auto source = travelMap.find("source");
+        auto destination = travelMap.find("destination");
+        WaypointPlan plan = consult.planLayovers(source->second, destination->second, customLayovers,
+                                                 choice == 1 ? RouteObjective::FLIGHTS : RouteObjective::DISTANCE);
+        drawBox("Order Custom Layovers");
+        if (!plan.reachable) {
+            cout << "There is no trip through every custom layover." << endl;
+        } else {
+            vector<Vertex<Airport>*> ordered;
+            for (int position : plan.order) {
+                ordered.push_back(customLayovers[position]);
+            }
+            customLayovers = ordered;
+            printCustomLayovers();
+            cout << makeBold("Flights: ") << plan.flights << endl;
+            cout << makeBold("Total distance: ") << plan.distance << " km" << endl;
+            if (!plan.exact) {
+                cout << makeBold("\nNote: ") << "with more than " << WaypointPlanner::HELD_KARP_MAX_WAYPOINTS
+                     << " custom layovers, this is the best order found, which may not be the best one" << endl;
+            }
+        }
+        backToMenu();
+        return;
+    }
+}
+
 void Script::showBestFlight() {
     clearScreen();
     while (true) {
@@ -815,7 +903,8 @@ void Script::showBestFlight() {
         /*user chooses*/
         cout << "1. Best flights in the same airline" << endl;
         cout << "2. Best flights considering all airlines" << endl;
-        cout << "3. [Back]" << endl;
+        cout << "3. Shortest distance flight considering all airlines" << endl;
+        cout << "4. [Back]" << endl;
         int choice_;
         cout << "\nEnter your choice: ";
         if (!(cin >> choice_)) {
@@ -825,26 +914,32 @@ void Script::showBestFlight() {
         }
         clearScreen();
 
-        if (choice_ == 3) {
+        if (choice_ == 4) {
             return;
         }
+        if (choice_ < 1 || choice_ > 3) {
+            continue;
+        }
         bool sameAirline = (choice_ == 1);
 
         vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths;  // Pair of path and distance
         auto source = travelMap.find("source");
         auto destination = travelMap.find("destination");
+        uint64_t numTrips = 0;
 
-        if (customLayoversChosen) {
+        if (choice_ == 3) {
+            totalPaths = consult.getShortestDistancePaths(source->second, destination->second, customLayoversChosen ? customLayovers : vector<Vertex<Airport>*>());
+        } else if (customLayoversChosen) {
             if (sameAirline) {
                 totalPaths = getBestPathsSameAirlinesWithCustomLayovers(source->second, destination->second);
             } else {
-                totalPaths = getBestPathsAllAirlinesWithCustomLayovers(source->second, destination->second);
+                totalPaths = getBestPathsAllAirlinesWithCustomLayovers(source->second, destination->second, numTrips);
             }
         } else {
             if (sameAirline) {
                 totalPaths = getBestPathsSameAirlines(source->second, destination->second);
             } else {
-                totalPaths = getBestPathsAllAirlines(source->second, destination->second);
+                totalPaths = getBestPathsAllAirlines(source->second, destination->second, numTrips);
             }
         }
 
@@ -858,16 +953,38 @@ void Script::showBestFlight() {
             return a.second.second < b.second.second;
         });
 
-        showListOfBestFlights(totalPaths);
+        // The alternatives mix airlines freely, so they are only offered with the flights considering all airlines.
+        // The front is not bounded, as a bounded one may miss the shortest itinerary or the one with the fewest changes
+        vector<ParetoItinerary> front;
+        if (choice_ == 2) {
+            front = consult.searchParetoItineraries(source->second, destination->second, customLayoversChosen ? customLayovers : vector<Vertex<Airport>*>(),
+                                                    numeric_limits<int>::max());
+        }
+        showListOfBestFlights(totalPaths, front, max<uint64_t>(numTrips, totalPaths.size()));
     }
 }
 
-void Script::showListOfBestFlights(vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths) {
+void Script::showListOfBestFlights(vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths, const vector<ParetoItinerary>& front, uint64_t numTrips) {
+    // The front is sorted by flights, so its first itinerary has the fewest stops
+    vector<pair<string, const ParetoItinerary*>> alternatives;
+    if (!front.empty()) {
+        auto shortest = min_element(front.begin(), front.end(), [](const ParetoItinerary& a, const ParetoItinerary& b) {
+            return a.distance < b.distance;
+        });
+        auto fewestChanges = min_element(front.begin(), front.end(), [](const ParetoItinerary& a, const ParetoItinerary& b) {
+            return a.changes < b.changes;
+        });
+        alternatives = {{"Fewest stops", &front[0]}, {"Shortest distance", &*shortest}, {"Fewest airline changes", &*fewestChanges}};
+    }
+
     while (true) {
         clearScreen();
         printSourceAndDestination();
 
         cout << "\nBest flight is with " << makeBold(totalPaths[0].second.first.size() - 2) << " lay-over(s)" << endl;
+        if (numTrips > totalPaths.size()) {
+            cout << makeBold("Note: ") << "showing " << totalPaths.size() << " of " << numTrips << " flights, starting with the shortest one" << endl;
+        }
 
         int index = 1;
         for (const auto& trip : totalPaths) {
@@ -883,6 +1000,23 @@ void Script::showListOfBestFlights(vector<pair<set<Airline>, pair<vector<Vertex<
             }
             cout << "   (" << distance << " km)" << endl;
         }
+
+        if (!alternatives.empty()) {
+            cout << "\n" << makeBold("Alternatives:") << endl;
+        }
+        for (const auto& alternative : alternatives) {
+            const ParetoItinerary& itinerary = *alternative.second;
+            cout << index++ << ". " << alternative.first << ": ";
+            for (auto it = itinerary.airports.begin(); it != itinerary.airports.end(); ++it) {
+                cout << (*it)->getInfo().getCode();
+
+                if (next(it) != itinerary.airports.end()) {
+                    cout << " \u25B6 ";
+                }
+            }
+            cout << "   (" << itinerary.airlines.size() << " flight(s), " << itinerary.distance << " km, "
+                 << itinerary.changes << " airline change(s))" << endl;
+        }
         cout << index << ". [Back]" << endl;
 
         int choice;
@@ -890,216 +1024,32 @@ void Script::showListOfBestFlights(vector<pair<set<Airline>, pair<vector<Vertex<
         cin >> choice;
         cout << "\n";
 
-        if (choice == totalPaths.size() + 1) {
+        int numListed = static_cast<int>(totalPaths.size());
+        int numAlternatives = static_cast<int>(alternatives.size());
+        if (choice == numListed + numAlternatives + 1) {
             return;
-        } else if (choice <= totalPaths.size() && choice > 0) {
+        } else if (choice <= numListed && choice > 0) {
             printBestFlightDetails(totalPaths[choice - 1]);
+        } else if (choice > numListed && choice <= numListed + numAlternatives) {
+            printItineraryDetails(*alternatives[choice - numListed - 1].second);
         }
     }
 }
 
 vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> Script::getBestPathsSameAirlines(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination) {
-    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths;
-    int minLayOvers = numeric_limits<int>::max();
-
-    for (auto sourceAirport : source) {
-        for (auto destinationAirport : destination) {
-            vector<vector<Vertex<Airport>*>> paths = consult.searchSmallestPathBetweenAirports(sourceAirport, destinationAirport);
-
-            for (auto v : paths) {
-                bool sameAirline = true;
-                set<Airline> same_airlines;
-
-                for (size_t i = 0; i < v.size() - 1; ++i) {
-                    if (i == 0) {
-                        same_airlines = consult.airlinesThatOperateBetweenAirports(v[i], v[i + 1]);
-                    } else {
-                        set<Airline> temp_airlines = consult.airlinesThatOperateBetweenAirports(v[i], v[i + 1]);
-                        set<Airline> intersection_result;
-                        set_intersection(same_airlines.begin(), same_airlines.end(), temp_airlines.begin(), temp_airlines.end(),
-                                inserter(intersection_result, intersection_result.begin()));
-                        same_airlines = intersection_result;
-                    }
-                    if (same_airlines.empty()) {
-                        sameAirline = false;
-                        break;
-                    }
-                }
-
-                if (sameAirline) {
-                    int currentLayOvers = v.size() - 2;
-                    if (currentLayOvers < minLayOvers) {
-                        minLayOvers = currentLayOvers;
-                        totalPaths.clear();
-                    }
-                    if (currentLayOvers == minLayOvers) {
-                        double distance = 0.0;
-                        auto it = v.begin();
-
-                        while (it != v.end() - 1) {
-                            distance += consult.getDistanceBetweenAirports(*it, *(it + 1));
-                            ++it;
-                        }
-                        totalPaths.push_back({ same_airlines, { v, distance } });
-                    }
-                }
-            }
-        }
-    }
-    return totalPaths;
+    return consult.getBestPathsSameAirlines(source, destination);
 }
 
-vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> Script::getBestPathsAllAirlines(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination) {
-    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths;
-    int minLayOvers = numeric_limits<int>::max();
-
-    for (auto sourceAirport : source) {
-        for (auto destinationAirport : destination) {
-            vector<vector<Vertex<Airport>*>> paths = consult.searchSmallestPathBetweenAirports(sourceAirport, destinationAirport);
-
-            for (auto v : paths) {
-                int currentLayOvers = v.size() - 2;
-
-                if (currentLayOvers < minLayOvers) {
-                    minLayOvers = currentLayOvers;
-                    totalPaths.clear();
-                }
-                if (currentLayOvers == minLayOvers) {
-                    double distance = 0.0;
-                    auto it = v.begin();
-                    while (it != v.end() - 1) {
-                        distance += consult.getDistanceBetweenAirports(*it, *(it + 1));
-                        ++it;
-                    }
-                    totalPaths.push_back({ set<Airline>(), { v, distance } });
-                }
-            }
-        }
-    }
-    return totalPaths;
+vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> Script::getBestPathsAllAirlines(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination, uint64_t& numTrips) {
+    return consult.getBestPathsAllAirlines(source, destination, {}, Consult::MAX_LISTED_TRIPS, numTrips);
 }
 
 vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> Script::getBestPathsSameAirlinesWithCustomLayovers(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination) {
-    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths;
-    int minLayOvers = numeric_limits<int>::max();
-
-    for (auto sourceAirport : source) {
-        for (auto destinationAirport : destination) {
-            vector<vector<Vertex<Airport>*>> paths;
-            vector<vector<Vertex<Airport>*>> temp = consult.searchSmallestPathBetweenAirports(sourceAirport, customLayovers[0]);
-            vector<vector<Vertex<Airport>*>> temp2;
-
-            for (size_t i = 0; i < customLayovers.size() - 1; ++i) {
-                vector<vector<Vertex<Airport>*>> pathsFromTo = consult.searchSmallestPathBetweenAirports(customLayovers[i], customLayovers[i + 1]);
-
-                for (auto a : temp) {
-                    for (auto b : pathsFromTo) {
-                        temp2.push_back(mergeVectors(a, b));
-                    }
-                }
-                temp = temp2;
-                temp2.clear();
-            }
-
-            temp2 = consult.searchSmallestPathBetweenAirports(customLayovers.back(), destinationAirport);
-            for (auto a : temp) {
-                for (auto b : temp2) {
-                    paths.push_back(mergeVectors(a, b));
-                }
-            }
-
-            for (auto v : paths) {
-                bool sameAirline = true;
-                set<Airline> same_airlines;
-
-                for (size_t i = 0; i < v.size() - 1; ++i) {
-                    if (i == 0) {
-                        same_airlines = consult.airlinesThatOperateBetweenAirports(v[i], v[i + 1]);
-                    } else {
-                        set<Airline> temp_airlines = consult.airlinesThatOperateBetweenAirports(v[i], v[i + 1]);
-                        set<Airline> intersection_result;
-                        set_intersection(same_airlines.begin(), same_airlines.end(), temp_airlines.begin(), temp_airlines.end(),
-                                         inserter(intersection_result, intersection_result.begin()));
-                        same_airlines = intersection_result;
-                    }
-                    if (same_airlines.empty()) {
-                        sameAirline = false;
-                        break;
-                    }
-                }
-
-                if (sameAirline) {
-                    int currentLayOvers = v.size() - 2;
-                    if (currentLayOvers < minLayOvers) {
-                        minLayOvers = currentLayOvers;
-                        totalPaths.clear();
-                    }
-                    if (currentLayOvers == minLayOvers) {
-                        double distance = 0.0;
-                        auto it = v.begin();
-                        while (it != v.end() - 1) {
-                            distance += consult.getDistanceBetweenAirports(*it, *(it + 1));
-                            ++it;
-                        }
-                        totalPaths.push_back({ same_airlines, { v, distance } });
-                    }
-                }
-            }
-        }
-    }
-    return totalPaths;
+    return consult.getBestPathsSameAirlines(source, destination, customLayovers);
 }
 
-vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> Script::getBestPathsAllAirlinesWithCustomLayovers(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination) {
-    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths;
-    int minLayOvers = numeric_limits<int>::max();
-
-    for (auto sourceAirport : source) {
-        for (auto destinationAirport : destination) {
-            vector<vector<Vertex<Airport>*>> paths;
-            vector<vector<Vertex<Airport>*>> temp = consult.searchSmallestPathBetweenAirports(sourceAirport, customLayovers[0]);
-            vector<vector<Vertex<Airport>*>> temp2;
-
-            for (size_t i = 0; i < customLayovers.size() - 1; ++i) {
-                vector<vector<Vertex<Airport>*>> pathsFromTo = consult.searchSmallestPathBetweenAirports(customLayovers[i], customLayovers[i + 1]);
-
-                for (auto a : temp) {
-                    for (auto b : pathsFromTo) {
-                        temp2.push_back(mergeVectors(a, b));
-                    }
-                }
-                temp = temp2;
-                temp2.clear();
-            }
-
-            temp2 = consult.searchSmallestPathBetweenAirports(customLayovers.back(), destinationAirport);
-            for (auto a : temp) {
-                for (auto b : temp2) {
-                    paths.push_back(mergeVectors(a, b));
-                }
-            }
-
-            for (auto v : paths) {
-                int currentLayOvers = v.size() - 2;
-
-                if (currentLayOvers < minLayOvers) {
-                    minLayOvers = currentLayOvers;
-                    totalPaths.clear();
-                }
-
-                if (currentLayOvers == minLayOvers) {
-                    double distance = 0.0;
-                    auto it = v.begin();
-                    while (it != v.end() - 1) {
-                        distance += consult.getDistanceBetweenAirports(*it, *(it + 1));
-                        ++it;
-                    }
-                    totalPaths.push_back({ set<Airline>(), { v, distance } });
-                }
-            }
-        }
-    }
-    return totalPaths;
+vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> Script::getBestPathsAllAirlinesWithCustomLayovers(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination, uint64_t& numTrips) {
+    return consult.getBestPathsAllAirlines(source, destination, customLayovers, Consult::MAX_LISTED_TRIPS, numTrips);
 }
 
 void Script::printBestFlightDetails(pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>> trip) {
@@ -1143,6 +1093,27 @@ void Script::printBestFlightDetails(pair<set<Airline>, pair<vector<Vertex<Airpor
     backToMenu();
 }
 
+void Script::printItineraryDetails(const ParetoItinerary& itinerary) {
+    clearScreen();
+    drawBox("Details about the trip");
+    cout << makeBold("Total distance: ") << itinerary.distance << " km" << endl;
+    cout << makeBold("Flights: ") << itinerary.airlines.size() << endl;
+    cout << makeBold("Airline changes: ") << itinerary.changes << "\n" << endl;
+
+    const AirlineRegistry& registry = consult.getAirlineRegistry();
+    for (size_t i = 0; i < itinerary.airports.size(); i++) {
+        cout << i + 1 << ". ";
+        printAirportInfoOneline(itinerary.airports[i]->getInfo());
+
+        if (i < itinerary.airlines.size()) {
+            cout << "   [Airline]: " << registry.getAirline(itinerary.airlines[i]).getCode() << endl;
+            cout << "             \u25BC" << endl;
+        }
+    }
+    cout << endl;
+    backToMenu();
+}
+
 void Script::printSourceAndDestination() {
     auto source = travelMap.find("source");
     auto destination = travelMap.find("destination");
@@ -17,9 +17,11 @@ public:
     /**
      * @brief Constructor for Script class.
      * @param dataGraph The graph containing airport data for the flight management system.
-     * @param airlinesInfo The set containing airlines information for the flight management system.
+     * @param airlineRegistry The registry containing airlines information for the flight management system.
+     * @param hierarchySource Function returning the contraction hierarchy of the graph, called by the first shortest
+     * distance search (nullptr for none).
      */
-    Script(const Graph<Airport>& dataGraph, const std::set<Airline> airlinesInfo);
+    Script(const Graph<Airport>& dataGraph, const AirlineRegistry& airlineRegistry, function<const ContractionHierarchy*()> hierarchySource = nullptr);
 
     /**
      * @brief Initiates the interactive system and displays the main menu.
@@ -170,13 +172,18 @@ private:
      */
     void maximumTrip();
 
+    /**
+     * @brief Displays how many airports have each eccentricity (the greatest number of flights needed to reach any airport from them) and the airports of the smallest one.
+     */
+    void airportEccentricities();
+
     /**
      * @brief Displays the top K airport with the greatest air traffic capacity (flights arriving and departing from the airport).
      */
     void topKAirportAirTraffic();
 
     /**
-     * @brief Displays all the airports that are essential to the network’s circulation capability, if removed, areas of the network start to be unreachable.
+     * @brief Displays all the airports that are essential to the network’s circulation capability, if removed, areas of the network start to be unreachable, along with the bridge routes and biconnected components.
      */
     void essentialAirports();
 
@@ -264,6 +271,13 @@ private:
      */
     void selectCustomLayovers();
 
+    /**
+     * @brief Reorders the custom layovers to visit them with the fewest flights or the shortest distance.
+     *
+     * Treats the custom layovers as a set instead of visiting them in the order they were added.
+     */
+    void orderCustomLayovers();
+
     /**
      * @brief Display 2 best flight options: travel by same or any airline from source to destination.
      *
@@ -276,12 +290,15 @@ private:
      * @brief Display a list of the best flights based on user preferences.
      *
      * This function presents the user with a list of the best flight options according to the option of airlines user had chosen,
-     * including the layovers, airports involved, and total distance for each option. The user can choose a specific flight for detailed
-     * information or return to the previous menu.
+     * including the layovers, airports involved, and total distance for each option. It is followed by the alternatives with the
+     * fewest stops, the shortest distance and the fewest airline changes taken from the Pareto front of the itineraries. The user
+     * can choose a specific flight for detailed information or return to the previous menu.
      *
      * @param totalPaths A vector containing information about each best flight option.
+     * @param front The itineraries that no other itinerary beats on flights, distance and airline changes at once, empty to offer no alternative.
+     * @param numTrips The number of best flight options, more than the listed ones if the list was capped.
      */
-    void showListOfBestFlights(vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths);
+    void showListOfBestFlights(vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> totalPaths, const vector<ParetoItinerary>& front, uint64_t numTrips);
 
     /**
      * @brief Find the best flight paths considering the same airline from source to destination.
@@ -307,9 +324,10 @@ private:
      *
      * @param source A vector of airport vertices representing the source airports.
      * @param destination A vector of airport vertices representing the destination airports.
+     * @param numTrips [out] The number of best flight options, of which at most Consult::MAX_LISTED_TRIPS are returned.
      * @return A vector of pairs, each containing an empty set of airlines, a vector of airport vertices representing the flight path, and the total distance of the flight.
      */
-    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> getBestPathsAllAirlines(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination);
+    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> getBestPathsAllAirlines(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination, uint64_t& numTrips);
 
     /**
      * @brief Find the best flight paths considering the same airline from source to destination with custom layovers.
@@ -335,9 +353,10 @@ private:
      *
      * @param source A vector of airport vertices representing the source airports.
      * @param destination A vector of airport vertices representing the destination airports.
+     * @param numTrips [out] The number of best flight options, of which at most Consult::MAX_LISTED_TRIPS are returned.
      * @return A vector of pairs, each containing an empty set of airlines, a vector of airport vertices representing the flight path, and the total distance of the flight.
      */
-    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> getBestPathsAllAirlinesWithCustomLayovers(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination);
+    vector<pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>>> getBestPathsAllAirlinesWithCustomLayovers(vector<Vertex<Airport>*> source, vector<Vertex<Airport>*> destination, uint64_t& numTrips);
 
     /**
      * @brief Print details about the best flight trip.
@@ -349,6 +368,16 @@ private:
      */
     void printBestFlightDetails(pair<set<Airline>, pair<vector<Vertex<Airport>*>, double>> trip);
 
+    /**
+     * @brief Print details about an itinerary of the Pareto front.
+     *
+     * This function prints the total distance, the number of flights and of airline changes of the itinerary, then each of its
+     * airports together with the airline of the flight leaving it.
+     *
+     * @param itinerary The itinerary, with the airline of each flight.
+     */
+    void printItineraryDetails(const ParetoItinerary& itinerary);
+
     /**
      * @brief Print the source and destination information for the travel selection.
      */
@@ -0,0 +1,38 @@
+#include "SearchContext.h"
+#include <algorithm>
+using namespace std;
+
+void SearchContext::begin(int numVertex) {
+    if (visitedStamp.size() < static_cast<size_t>(numVertex)) {
+        visitedStamp.resize(numVertex, 0);
+        processingStamp.resize(numVertex, 0);
+        backwardStamp.resize(numVertex, 0);
+        markStamp.resize(numVertex, 0);
+        marks.resize(numVertex);
+        nums.resize(numVertex);
+        lows.resize(numVertex);
+        distances.resize(numVertex);
+        parents.resize(numVertex);
+        backwardDistances.resize(numVertex);
+        successors.resize(numVertex);
+        costs.resize(numVertex);
+        estimates.resize(numVertex);
+    }
+
+    if (++epoch == 0) {
+        fill(visitedStamp.begin(), visitedStamp.end(), 0);
+        fill(processingStamp.begin(), processingStamp.end(), 0);
+        fill(backwardStamp.begin(), backwardStamp.end(), 0);
+        fill(markStamp.begin(), markStamp.end(), 0);
+        epoch = 1;
+    }
+    vertexQueue.clear();
+    backwardVertexQueue.clear();
+    linkList.clear();
+    vertexHeap.clear();
+}
+
+SearchContext& SearchContext::local() {
+    thread_local SearchContext context;
+    return context;
+}
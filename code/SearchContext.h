@@ -0,0 +1,211 @@
+/**
+ * @file SearchContext.h
+ * @brief Header file containing the per-query scratch state of graph traversals.
+ *
+ * Traversals used to mark the vertices of the shared graph, which cost O(V) per query just to clear the marks
+ * and prevented queries from running concurrently. The 'SearchContext' class holds that state in arrays indexed
+ * by vertex ID instead. Marks are stamped with the epoch of the query that set them, so starting a new query only
+ * increments the epoch and the arrays are never cleared.
+ */
+
+#ifndef AED_AIRPORTS_SEARCHCONTEXT_H
+#define AED_AIRPORTS_SEARCHCONTEXT_H
+
+#include "DaryHeap.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SearchContext
+ * @brief Visitation state of one traversal at a time, indexed by vertex ID.
+ *
+ * The values returned by num(), low(), distance() and parent() are only meaningful for the vertices visited
+ * since the last call to begin().
+ */
+class SearchContext {
+private:
+    uint32_t epoch = 0;                     ///< Stamp of the current traversal, never 0.
+    std::vector<uint32_t> visitedStamp;     ///< Epoch in which each vertex was last visited.
+    std::vector<uint32_t> processingStamp;  ///< Epoch in which each vertex is being processed, 0 if it is not.
+    std::vector<uint32_t> backwardStamp;    ///< Epoch in which each vertex was last visited by a backward search.
+    std::vector<uint32_t> markStamp;        ///< Epoch in which each vertex was last marked.
+    std::vector<int> marks;                 ///< Value of the mark of each vertex.
+    std::vector<int> nums;                  ///< Discovery order of each vertex.
+    std::vector<int> lows;                  ///< Lowest discovery order reachable from each vertex.
+    std::vector<int> distances;             ///< Distance of each vertex to the source.
+    std::vector<int> parents;               ///< Predecessor of each vertex in the traversal tree.
+    std::vector<int> backwardDistances;     ///< Distance of each vertex to the target of a backward search.
+    std::vector<int> successors;            ///< Successor of each vertex in the backward traversal tree.
+    std::vector<std::pair<double, double>> costs;   ///< Cost of the best path found to each vertex, compared lexicographically.
+    std::vector<double> estimates;          ///< Estimated cost from each vertex to the target of the traversal.
+    DaryHeap<std::pair<double, double>, int> vertexHeap;    ///< Scratch priority queue of vertices, cleared by begin().
+    std::vector<int> vertexQueue;           ///< Scratch vertex queue or stack, cleared by begin().
+    std::vector<int> backwardVertexQueue;   ///< Scratch vertex queue of a backward search, cleared by begin().
+    std::vector<std::pair<int, int>> linkList; ///< Scratch list of (vertex, next link) pairs, cleared by begin().
+
+public:
+    /**
+     * @brief Starts a new traversal, forgetting the marks of the previous one.
+     * @param numVertex The number of vertices of the traversed graph.
+     *
+     * Time Complexity: O(1) amortized, O(V) only when the arrays grow or the epoch wraps around.
+     */
+    void begin(int numVertex);
+
+    /**
+     * @brief Checks if a vertex was visited in the current traversal.
+     * @param v The vertex ID.
+     * @return True if the vertex was visited, otherwise false.
+     */
+    bool isVisited(int v) const { return visitedStamp[v] == epoch; }
+
+    /**
+     * @brief Marks a vertex as visited in the current traversal.
+     * @param v The vertex ID.
+     */
+    void setVisited(int v) { visitedStamp[v] = epoch; }
+
+    /**
+     * @brief Checks if a vertex is being processed in the current traversal.
+     * @param v The vertex ID.
+     * @return True if the vertex is being processed, otherwise false.
+     */
+    bool isProcessing(int v) const { return processingStamp[v] == epoch; }
+
+    /**
+     * @brief Sets the processing status of a vertex in the current traversal.
+     * @param v The vertex ID.
+     * @param p Boolean indicating whether the vertex is being processed.
+     */
+    void setProcessing(int v, bool p) { processingStamp[v] = p ? epoch : 0; }
+
+    /**
+     * @brief Checks if a vertex was visited by the backward search of the current traversal.
+     * @param v The vertex ID.
+     * @return True if the vertex was visited backward, otherwise false.
+     */
+    bool isVisitedBackward(int v) const { return backwardStamp[v] == epoch; }
+
+    /**
+     * @brief Marks a vertex as visited by the backward search of the current traversal.
+     * @param v The vertex ID.
+     */
+    void setVisitedBackward(int v) { backwardStamp[v] = epoch; }
+
+    /**
+     * @brief Checks if a vertex was marked in the current traversal (e.g. as one of its targets).
+     * @param v The vertex ID.
+     * @return True if the vertex is marked, otherwise false.
+     */
+    bool isMarked(int v) const { return markStamp[v] == epoch; }
+
+    /**
+     * @brief Marks a vertex in the current traversal.
+     * @param v The vertex ID.
+     * @param value The value attached to the mark.
+     */
+    void setMark(int v, int value) {
+        markStamp[v] = epoch;
+        marks[v] = value;
+    }
+
+    /**
+     * @brief Retrieves the value attached to the mark of a vertex.
+     * @param v The vertex ID, marked in the current traversal.
+     * @return The value of the mark.
+     */
+    int mark(int v) const { return marks[v]; }
+
+    /**
+     * @brief Accesses the discovery order of a vertex.
+     * @param v The vertex ID.
+     * @return Reference to the discovery order.
+     */
+    int& num(int v) { return nums[v]; }
+
+    /**
+     * @brief Accesses the lowest discovery order reachable from a vertex.
+     * @param v The vertex ID.
+     * @return Reference to the low value.
+     */
+    int& low(int v) { return lows[v]; }
+
+    /**
+     * @brief Accesses the distance of a vertex to the source of the traversal.
+     * @param v The vertex ID.
+     * @return Reference to the distance.
+     */
+    int& distance(int v) { return distances[v]; }
+
+    /**
+     * @brief Accesses the predecessor of a vertex in the traversal tree.
+     * @param v The vertex ID.
+     * @return Reference to the predecessor ID.
+     */
+    int& parent(int v) { return parents[v]; }
+
+    /**
+     * @brief Accesses the distance of a vertex to the target of a backward search.
+     * @param v The vertex ID.
+     * @return Reference to the backward distance.
+     */
+    int& backwardDistance(int v) { return backwardDistances[v]; }
+
+    /**
+     * @brief Accesses the successor of a vertex in the backward traversal tree.
+     * @param v The vertex ID.
+     * @return Reference to the successor ID.
+     */
+    int& successor(int v) { return successors[v]; }
+
+    /**
+     * @brief Accesses the cost of the best path found to a vertex, as a (primary, secondary) pair.
+     * @param v The vertex ID.
+     * @return Reference to the cost.
+     */
+    std::pair<double, double>& cost(int v) { return costs[v]; }
+
+    /**
+     * @brief Accesses the estimated cost from a vertex to the target of the traversal.
+     * @param v The vertex ID.
+     * @return Reference to the estimate.
+     */
+    double& estimate(int v) { return estimates[v]; }
+
+    /**
+     * @brief Accesses the scratch vertex queue (or stack) of the traversal.
+     * @return Reference to the queue, empty after begin().
+     */
+    std::vector<int>& queue() { return vertexQueue; }
+
+    /**
+     * @brief Accesses the scratch vertex queue of the backward search of a bidirectional traversal.
+     * @return Reference to the queue, empty after begin().
+     */
+    std::vector<int>& backwardQueue() { return backwardVertexQueue; }
+
+    /**
+     * @brief Accesses the scratch priority queue of the traversal, keyed by (primary, secondary) cost.
+     * @return Reference to the priority queue, empty after begin().
+     */
+    DaryHeap<std::pair<double, double>, int>& heap() { return vertexHeap; }
+
+    /**
+     * @brief Accesses the scratch link list of the traversal, used to chain several values per vertex
+     * (each vertex keeps the index of its first link, each link a value and the index of the next one).
+     * @return Reference to the link list, empty after begin().
+     */
+    std::vector<std::pair<int, int>>& links() { return linkList; }
+
+    /**
+     * @brief Retrieves the context of the calling thread.
+     * @return Reference to the context owned by the calling thread.
+     *
+     * Queries running on different threads never share a context. A query must finish using it before starting
+     * another one on the same thread.
+     */
+    static SearchContext& local();
+};
+
+#endif //AED_AIRPORTS_SEARCHCONTEXT_H
@@ -0,0 +1,222 @@
+#include "ShortestPathDag.h"
+#include <limits>
+
+ShortestPathDag::ShortestPathDag(const FrozenGraph& graph, int source, int target, SearchContext& context)
+        : ShortestPathDag(graph, vector<int>{source}, vector<int>{target}, context) {}
+
+ShortestPathDag::ShortestPathDag(const FrozenGraph& graph, const vector<int>& sources, const vector<int>& targets, SearchContext& context) {
+    // Each target is reached through its own arrival vertex, numbered after the real ones, so that a search from
+    // an airport to itself finds round trips and each path still ends at a concrete target
+    int numVertex = graph.getNumVertex();
+    context.begin(numVertex + static_cast<int>(targets.size()));
+    vector<int>& forward = context.queue();
+    vector<int>& backward = context.backwardQueue();
+    vector<pair<int, int>>& links = context.links();
+
+    for (int source : sources) {
+        if (context.isVisited(source))
+            continue;
+        context.setVisited(source);
+        context.distance(source) = 0;
+        context.parent(source) = -1;
+        forward.push_back(source);
+    }
+    for (size_t k = 0; k < targets.size(); k++) {
+        if (context.isMarked(targets[k]))
+            continue;
+        int arrival = numVertex + static_cast<int>(k);
+        context.setMark(targets[k], arrival);
+        context.setVisitedBackward(arrival);
+        context.backwardDistance(arrival) = 0;
+        context.successor(arrival) = -1;
+        backward.push_back(arrival);
+    }
+    auto vertexOf = [&](int v) { return v < numVertex ? v : targets[v - numVertex]; };
+
+    // Expand one whole level of the smaller frontier at a time, until a level reaches the other search
+    size_t forwardHead = 0, backwardHead = 0;
+    int shortest = numeric_limits<int>::max();
+    bool forwardLast = true;
+    size_t levelStart = 0;
+    while (shortest == numeric_limits<int>::max()) {
+        size_t forwardEnd = forward.size(), backwardEnd = backward.size();
+        if (forwardHead == forwardEnd || backwardHead == backwardEnd)
+            return;
+        forwardLast = forwardEnd - forwardHead <= backwardEnd - backwardHead;
+
+        if (forwardLast) {
+            levelStart = forwardEnd;
+            for (; forwardHead < forwardEnd; forwardHead++) {
+                int u = forward[forwardHead];
+                int d = context.distance(u);
+                for (int e = graph.edgesBegin(u); e < graph.edgesEnd(u); e++) {
+                    int w = graph.getTarget(e);
+                    if (context.isMarked(w))
+                        w = context.mark(w);
+                    if (!context.isVisited(w)) {
+                        context.setVisited(w);
+                        context.distance(w) = d + 1;
+                        context.parent(w) = -1;
+                        forward.push_back(w);
+                    }
+                    if (context.distance(w) != d + 1)
+                        continue;
+                    links.emplace_back(u, context.parent(w));
+                    context.parent(w) = static_cast<int>(links.size()) - 1;
+                    if (context.isVisitedBackward(w))
+                        shortest = min(shortest, d + 1 + context.backwardDistance(w));
+                }
+            }
+        } else {
+            levelStart = backwardEnd;
+            for (; backwardHead < backwardEnd; backwardHead++) {
+                int x = backward[backwardHead];
+                int d = context.backwardDistance(x);
+                int destination = vertexOf(x);
+                for (int i = graph.inEdgesBegin(destination); i < graph.inEdgesEnd(destination); i++) {
+                    int y = graph.getSource(i);
+                    // Targets are only reached through their arrival vertices, unless they are sources as well
+                    if (context.isMarked(y) && !(context.isVisited(y) && context.distance(y) == 0))
+                        continue;
+                    if (!context.isVisitedBackward(y)) {
+                        context.setVisitedBackward(y);
+                        context.backwardDistance(y) = d + 1;
+                        context.successor(y) = -1;
+                        backward.push_back(y);
+                    }
+                    if (context.backwardDistance(y) != d + 1)
+                        continue;
+                    links.emplace_back(x, context.successor(y));
+                    context.successor(y) = static_cast<int>(links.size()) - 1;
+                    if (context.isVisited(y))
+                        shortest = min(shortest, context.distance(y) + d + 1);
+                }
+            }
+        }
+    }
+    flights = shortest;
+
+    // Every smallest path goes through exactly one vertex of the level where both searches met
+    vector<int> collected;
+    const vector<int>& level = forwardLast ? forward : backward;
+    for (size_t i = levelStart; i < level.size(); i++) {
+        int v = level[i];
+        if (context.isVisited(v) && context.isVisitedBackward(v) && context.distance(v) + context.backwardDistance(v) == shortest) {
+            context.setProcessing(v, true);
+            collected.push_back(v);
+        }
+    }
+
+    // Walk the forward links back to the sources and the backward links on to the arrivals, collecting the vertices
+    // of the smallest paths and their (vertex, predecessor) pairs
+    vector<int> toArrival(collected);
+    vector<pair<int, int>> edges;
+    for (size_t i = 0; i < collected.size(); i++) {
+        int v = collected[i];
+        for (int link = context.parent(v); link != -1; link = links[link].second) {
+            int p = links[link].first;
+            edges.emplace_back(v, p);
+            if (!context.isProcessing(p)) {
+                context.setProcessing(p, true);
+                collected.push_back(p);
+            }
+        }
+    }
+    for (size_t i = 0; i < toArrival.size(); i++) {
+        int v = toArrival[i];
+        for (int link = context.successor(v); link != -1; link = links[link].second) {
+            int z = links[link].first;
+            edges.emplace_back(z, v);
+            if (!context.isProcessing(z)) {
+                context.setProcessing(z, true);
+                toArrival.push_back(z);
+                collected.push_back(z);
+            }
+        }
+    }
+
+    // Number the vertices from the arrivals back to the sources, after the root, so that predecessors come after
+    // their successors. The root precedes every arrival.
+    auto stepsToArrival = [&](int v) {
+        return context.isVisitedBackward(v) ? context.backwardDistance(v) : shortest - context.distance(v);
+    };
+    vector<int> firstOfStep(shortest + 2, 0);
+    firstOfStep[0] = 1;
+    for (int v : collected)
+        firstOfStep[stepsToArrival(v) + 1]++;
+    for (int step = 0; step <= shortest; step++)
+        firstOfStep[step + 1] += firstOfStep[step];
+    nodes.resize(collected.size() + 1, nullptr);
+    for (int v : collected) {
+        int node = firstOfStep[stepsToArrival(v)]++;
+        context.num(v) = node;
+        nodes[node] = graph.getVertex(vertexOf(v));
+        if (v >= numVertex)
+            edges.emplace_back(-1, v);
+    }
+
+    auto nodeOf = [&](int v) { return v < 0 ? 0 : context.num(v); };
+    parentOffsets.assign(nodes.size() + 1, 0);
+    for (const auto& edge : edges)
+        parentOffsets[nodeOf(edge.first) + 1]++;
+    for (size_t n = 0; n < nodes.size(); n++)
+        parentOffsets[n + 1] += parentOffsets[n];
+    parents.resize(edges.size());
+    vector<int> next(parentOffsets.begin(), parentOffsets.end() - 1);
+    for (const auto& edge : edges)
+        parents[next[nodeOf(edge.first)]++] = nodeOf(edge.second);
+}
+
+uint64_t ShortestPathDag::countPaths() const {
+    if (empty())
+        return 0;
+
+    // Predecessors are always numbered after their successors, so the nodes are counted from the source
+    vector<uint64_t> paths(nodes.size());
+    for (int n = static_cast<int>(nodes.size()) - 1; n >= 0; n--) {
+        if (parentOffsets[n] == parentOffsets[n + 1]) {
+            paths[n] = 1;
+            continue;
+        }
+        paths[n] = 0;
+        for (int i = parentOffsets[n]; i < parentOffsets[n + 1]; i++) {
+            uint64_t through = paths[parents[i]];
+            paths[n] = (paths[n] > numeric_limits<uint64_t>::max() - through) ? numeric_limits<uint64_t>::max() : paths[n] + through;
+        }
+    }
+    return paths[0];
+}
+
+ShortestPathDag::Iterator::Iterator(const ShortestPathDag* dag) : dag(dag) {
+    stepNodes.assign(dag->flights + 2, 0);
+    choices.assign(dag->flights + 1, 0);
+    path.resize(dag->flights + 1);
+    descend(0);
+}
+
+void ShortestPathDag::Iterator::descend(int step) {
+    int flights = dag->flights;
+    for (int k = step; k <= flights; k++) {
+        if (k > step)
+            choices[k] = 0;
+        int node = dag->parents[dag->parentOffsets[stepNodes[k]] + choices[k]];
+        stepNodes[k + 1] = node;
+        path[flights - k] = dag->nodes[node];
+    }
+}
+
+ShortestPathDag::Iterator& ShortestPathDag::Iterator::operator++() {
+    for (int k = dag->flights; k >= 0; k--) {
+        int node = stepNodes[k];
+        if (choices[k] + 1 < dag->parentOffsets[node + 1] - dag->parentOffsets[node]) {
+            choices[k]++;
+            descend(k);
+            return *this;
+        }
+    }
+    dag = nullptr;
+    stepNodes.clear();
+    choices.clear();
+    path.clear();
+    return *this;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file ShortestPathDag.h
+ * @brief Header file containing the predecessor DAG of the smallest paths between airports.
+ *
+ * This file defines the 'ShortestPathDag' class. A bidirectional breadth-first search, forward from the source
+ * and backward from the target over the incoming edges, records for every vertex all of its neighbors one hop
+ * closer to the start of its search, instead of copying a whole path into the queue for every vertex. The
+ * searches stop at the first level where they meet, so they only explore two balls of about half the radius.
+ * Only the part of the links lying on the smallest paths is kept, and the paths are enumerated lazily from it,
+ * so every path with the fewest flights is found while the memory stays O(V+E). Several sources and targets
+ * (e.g. the airports of two cities) are searched at once, instead of running one search per pair of airports.
+ */
+
+#ifndef AED_AIRPORTS_SHORTESTPATHDAG_H
+#define AED_AIRPORTS_SHORTESTPATHDAG_H
+
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+#include <cstdint>
+#include <iterator>
+
+/**
+ * @class ShortestPathDag
+ * @brief Every path with the fewest flights from a set of source airports to a set of target airports, stored as a DAG.
+ *
+ * Node 0 is a root preceded by the targets that end a smallest path, the other nodes are numbered from the
+ * targets towards the sources, and each node keeps the nodes preceding it on a smallest path. When an airport
+ * is both a source and a target, the paths from it to itself are the smallest round trips. Each path starts
+ * and ends at concrete airports, which tell the pair of airports it connects. The DAG does not depend on the
+ * search context once built, so it can outlive the query.
+ */
+class ShortestPathDag {
+private:
+    vector<Vertex<Airport>*> nodes; ///< The airport of each node (nullptr for the root).
+    vector<int> parentOffsets;      ///< The predecessors of node 'n' are stored in [parentOffsets[n], parentOffsets[n + 1]).
+    vector<int> parents;            ///< The predecessor nodes of every node, stored contiguously.
+    int flights = 0;                ///< The number of flights of each path, 0 if the target is unreachable.
+
+public:
+    /**
+     * @class Iterator
+     * @brief Forward iterator over the smallest paths, building each path only when it is reached.
+     *
+     * The iterator keeps the predecessor chosen at each step back from the target, and advances like an
+     * odometer: the choice closest to the source moves first, and the following ones restart from their first
+     * predecessor. Only the airports after the changed step are rewritten.
+     */
+    class Iterator {
+    private:
+        const ShortestPathDag* dag = nullptr;   ///< The enumerated DAG, nullptr for the end iterator.
+        vector<int> stepNodes;                  ///< The node at each step back from the root (step 1 is the target).
+        vector<int> choices;                    ///< The predecessor chosen at each step, as an index in its range.
+        vector<Vertex<Airport>*> path;          ///< The current path, from the source to the target.
+
+        /**
+         * @brief Chooses the first predecessor at every step from a given one up to the source.
+         * @param step The first step to fill.
+         */
+        void descend(int step);
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = vector<Vertex<Airport>*>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        /**
+         * @brief Constructs the end iterator.
+         */
+        Iterator() = default;
+
+        /**
+         * @brief Constructs an iterator at the first path of a DAG.
+         * @param dag The DAG, with at least one path.
+         */
+        explicit Iterator(const ShortestPathDag* dag);
+
+        reference operator*() const { return path; }
+        pointer operator->() const { return &path; }
+
+        /**
+         * @brief Advances to the next path, or to the end if it was the last one.
+         * @return Reference to this iterator.
+         *
+         * Time Complexity: O(L) amortized, where L stands for the number of flights of the paths.
+         */
+        Iterator& operator++();
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return dag == other.dag && choices == other.choices; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Constructs an empty DAG, without any path.
+     */
+    ShortestPathDag() = default;
+
+    /**
+     * @brief Searches the smallest paths between two airports and builds their DAG.
+     * @param graph The CSR snapshot of the airport graph.
+     * @param source The vertex ID of the starting airport.
+     * @param target The vertex ID of the destination airport.
+     * @param context The search context used by the bidirectional breadth-first search.
+     *
+     * Time Complexity: O(V+E) where V stands for vertices and E for edges.
+     */
+    ShortestPathDag(const FrozenGraph& graph, int source, int target, SearchContext& context);
+
+    /**
+     * @brief Searches the smallest paths from any of the source airports to any of the target airports and builds their DAG.
+     * @param graph The CSR snapshot of the airport graph.
+     * @param sources The vertex IDs of the starting airports, all searched at distance 0.
+     * @param targets The vertex IDs of the destination airports.
+     * @param context The search context used by the bidirectional breadth-first search.
+     *
+     * Time Complexity: O(V+E) where V stands for vertices and E for edges. Each step expands a whole level of the
+     * smaller frontier, and the search stops once the level where both searches meet is complete.
+     */
+    ShortestPathDag(const FrozenGraph& graph, const vector<int>& sources, const vector<int>& targets, SearchContext& context);
+
+    /**
+     * @brief Checks if the target is reachable from the source.
+     * @return True if there is no path, otherwise false.
+     */
+    bool empty() const { return flights == 0; }
+
+    /**
+     * @brief Retrieves the number of flights of the smallest paths.
+     * @return The number of flights, 0 if there is no path.
+     */
+    int getNumFlights() const { return flights; }
+
+    /**
+     * @brief Counts the smallest paths without enumerating them.
+     * @return The number of paths, saturated at the maximum value of uint64_t.
+     *
+     * Time Complexity: O(N+P) where N stands for the nodes and P for the predecessor links of the DAG.
+     */
+    uint64_t countPaths() const;
+
+    /**
+     * @brief Retrieves the number of nodes, including the root.
+     * @return The number of nodes.
+     */
+    int getNumNodes() const { return static_cast<int>(nodes.size()); }
+
+    /**
+     * @brief Retrieves the airport of a node.
+     * @param n The node.
+     * @return Pointer to the airport vertex, nullptr for the root.
+     */
+    Vertex<Airport>* getNode(int n) const { return nodes[n]; }
+
+    /**
+     * @brief Retrieves the position of the first predecessor of a node.
+     * @param n The node.
+     * @return The position of the first predecessor, to use with getParent().
+     */
+    int parentsBegin(int n) const { return parentOffsets[n]; }
+
+    /**
+     * @brief Retrieves the position past the last predecessor of a node.
+     * @param n The node.
+     * @return The position past the last predecessor.
+     */
+    int parentsEnd(int n) const { return parentOffsets[n + 1]; }
+
+    /**
+     * @brief Retrieves a predecessor.
+     * @param i The position of the predecessor.
+     * @return The predecessor node.
+     */
+    int getParent(int i) const { return parents[i]; }
+
+    /**
+     * @brief Retrieves an iterator at the first path.
+     * @return The iterator, equal to end() if there is no path.
+     */
+    Iterator begin() const { return empty() ? Iterator() : Iterator(this); }
+
+    /**
+     * @brief Retrieves the end iterator.
+     * @return The iterator past the last path.
+     */
+    Iterator end() const { return Iterator(); }
+};
+
+#endif //AED_AIRPORTS_SHORTESTPATHDAG_H
@@ -0,0 +1,205 @@
+#include "Snapshot.h"
+#include "CsvReader.h"
+#include "FrozenGraph.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+using namespace std;
+
+static const char SNAPSHOT_MAGIC[8] = {'A', 'I', 'R', 'S', 'N', 'A', 'P', '\0'};
+
+static size_t Padded(size_t bytes) {
+    return (bytes + 7) & ~size_t(7);
+}
+
+static uint64_t Checksum(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+    return hash;
+}
+
+static void AppendSection(vector<char>& payload, const void* data, size_t bytes) {
+    const char* begin = static_cast<const char*>(data);
+    payload.insert(payload.end(), begin, begin + bytes);
+    payload.resize(Padded(payload.size()), 0);
+}
+
+static SnapshotString AddString(string& strings, const string& s) {
+    SnapshotString ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(s.size())};
+    strings += s;
+    return ref;
+}
+
+bool WriteSnapshot(const string& path, const Graph<Airport>& graph, const AirlineRegistry& registry,
+                   const ContractionHierarchy& hierarchy) {
+    FrozenGraph frozen(graph);
+    string strings;
+
+    vector<SnapshotAirline> airlines;
+    for (const auto& airline : registry.getAirlines()) {
+        airlines.push_back({AddString(strings, airline.getCode()), AddString(strings, airline.getName()),
+                            AddString(strings, airline.getCallsign()), AddString(strings, airline.getCountry())});
+    }
+
+    vector<SnapshotAirport> airports;
+    vector<uint32_t> offsets, targets, airlineOffsets;
+    vector<double> distances;
+    vector<AirlineId> airlineIds;
+    for (int v = 0; v < frozen.getNumVertex(); v++) {
+        Vertex<Airport>* vertex = frozen.getVertex(v);
+        Airport airport = vertex->getInfo();
+        airports.push_back({AddString(strings, airport.getCode()), AddString(strings, airport.getName()),
+                            AddString(strings, airport.getCity()), AddString(strings, airport.getCountry()),
+                            airport.getLocation().latitude, airport.getLocation().longitude,
+                            vertex->getFlightsFrom(), vertex->getFlightsTo()});
+        offsets.push_back(frozen.edgesBegin(v));
+    }
+    offsets.push_back(frozen.getNumEdges());
+
+    airlineOffsets.push_back(0);
+    for (int e = 0; e < frozen.getNumEdges(); e++) {
+        targets.push_back(frozen.getTarget(e));
+        distances.push_back(frozen.getDistance(e));
+        airlineIds.insert(airlineIds.end(), frozen.airlinesBegin(e), frozen.airlinesEnd(e));
+        airlineOffsets.push_back(static_cast<uint32_t>(airlineIds.size()));
+    }
+
+    vector<int32_t> ranks(hierarchy.getRanks().begin(), hierarchy.getRanks().end());
+    vector<SnapshotArc> arcs;
+    for (const auto& arc : hierarchy.getArcs())
+        arcs.push_back({arc.source, arc.target, arc.middle, arc.flights, arc.distance});
+
+    vector<char> payload;
+    AppendSection(payload, airlines.data(), airlines.size() * sizeof(SnapshotAirline));
+    AppendSection(payload, airports.data(), airports.size() * sizeof(SnapshotAirport));
+    AppendSection(payload, offsets.data(), offsets.size() * sizeof(uint32_t));
+    AppendSection(payload, targets.data(), targets.size() * sizeof(uint32_t));
+    AppendSection(payload, distances.data(), distances.size() * sizeof(double));
+    AppendSection(payload, airlineOffsets.data(), airlineOffsets.size() * sizeof(uint32_t));
+    AppendSection(payload, airlineIds.data(), airlineIds.size() * sizeof(AirlineId));
+    AppendSection(payload, ranks.data(), ranks.size() * sizeof(int32_t));
+    AppendSection(payload, arcs.data(), arcs.size() * sizeof(SnapshotArc));
+    AppendSection(payload, strings.data(), strings.size());
+
+    SnapshotHeader header{};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.numAirlines = static_cast<uint32_t>(airlines.size());
+    header.numAirports = static_cast<uint32_t>(airports.size());
+    header.numEdges = static_cast<uint32_t>(targets.size());
+    header.numAirlineIds = static_cast<uint32_t>(airlineIds.size());
+    header.numRanks = static_cast<uint32_t>(ranks.size());
+    header.numArcs = static_cast<uint32_t>(arcs.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+    header.payloadBytes = payload.size();
+    header.checksum = Checksum(payload.data(), payload.size());
+
+    string temporary = path + ".tmp";
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload.data(), static_cast<streamsize>(payload.size()));
+        if (!file.good()) return false;
+    }
+
+    error_code error;
+    filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+bool ReadSnapshot(const string& path, Graph<Airport>& graph, AirlineRegistry& registry, ContractionHierarchy& hierarchy) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    string_view content = file.view();
+    if (content.size() < sizeof(SnapshotHeader)) return false;
+
+    SnapshotHeader header;
+    memcpy(&header, content.data(), sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SNAPSHOT_VERSION)
+        return false;
+    if (header.numRanks != 0 && header.numRanks != header.numAirports)
+        return false;
+
+    // Every section must fit exactly in the payload, which must match its checksum
+    size_t sizes[] = {
+            header.numAirlines * sizeof(SnapshotAirline), header.numAirports * sizeof(SnapshotAirport),
+            (header.numAirports + size_t(1)) * sizeof(uint32_t), header.numEdges * sizeof(uint32_t),
+            header.numEdges * sizeof(double), (header.numEdges + size_t(1)) * sizeof(uint32_t),
+            header.numAirlineIds * sizeof(AirlineId), header.numRanks * sizeof(int32_t),
+            header.numArcs * sizeof(SnapshotArc), header.stringBytes
+    };
+    const char* payload = content.data() + sizeof(SnapshotHeader);
+    const char* sections[10];
+    size_t position = 0;
+    for (int i = 0; i < 10; i++) {
+        sections[i] = payload + position;
+        position += Padded(sizes[i]);
+    }
+    if (position != header.payloadBytes || content.size() - sizeof(SnapshotHeader) != header.payloadBytes)
+        return false;
+    if (Checksum(payload, header.payloadBytes) != header.checksum)
+        return false;
+
+    auto airlines = reinterpret_cast<const SnapshotAirline*>(sections[0]);
+    auto airports = reinterpret_cast<const SnapshotAirport*>(sections[1]);
+    auto offsets = reinterpret_cast<const uint32_t*>(sections[2]);
+    auto targets = reinterpret_cast<const uint32_t*>(sections[3]);
+    auto distances = reinterpret_cast<const double*>(sections[4]);
+    auto airlineOffsets = reinterpret_cast<const uint32_t*>(sections[5]);
+    auto airlineIds = reinterpret_cast<const AirlineId*>(sections[6]);
+    auto ranks = reinterpret_cast<const int32_t*>(sections[7]);
+    auto arcs = reinterpret_cast<const SnapshotArc*>(sections[8]);
+    const char* strings = sections[9];
+    auto str = [strings](SnapshotString s) { return string(strings + s.offset, s.length); };
+
+    for (uint32_t a = 0; a < header.numAirlines; a++) {
+        const SnapshotAirline& airline = airlines[a];
+        registry.addAirline(Airline(str(airline.code), str(airline.name), str(airline.callsign), str(airline.country)));
+    }
+
+    for (uint32_t v = 0; v < header.numAirports; v++) {
+        const SnapshotAirport& airport = airports[v];
+        graph.addVertex(Airport(str(airport.code), str(airport.name), str(airport.city), str(airport.country),
+                                {airport.latitude, airport.longitude}));
+    }
+
+    auto vertices = graph.getVertexSet();
+    for (uint32_t v = 0; v < header.numAirports; v++) {
+        vertices[v]->setFlightsFrom(airports[v].flightsFrom);
+        vertices[v]->setFlightsTo(airports[v].flightsTo);
+        for (uint32_t e = offsets[v]; e < offsets[v + 1]; e++) {
+            auto& flight = graph.addEdge(vertices[v], vertices[targets[e]], distances[e]);
+            for (uint32_t i = airlineOffsets[e]; i < airlineOffsets[e + 1]; i++)
+                flight.addAirline(airlineIds[i]);
+        }
+    }
+
+    if (header.numRanks != 0) {
+        vector<ContractionHierarchy::Arc> hierarchyArcs;
+        for (uint32_t a = 0; a < header.numArcs; a++)
+            hierarchyArcs.push_back({arcs[a].source, arcs[a].target, arcs[a].middle, arcs[a].flights, arcs[a].distance});
+        hierarchy = ContractionHierarchy(vector<int>(ranks, ranks + header.numRanks), move(hierarchyArcs));
+    }
+    return true;
+}
+
+bool IsSnapshotFresh(const string& path, const vector<string>& sources) {
+    error_code error;
+    auto snapshotTime = filesystem::last_write_time(path, error);
+    if (error) return false;
+
+    for (const auto& source : sources) {
+        auto sourceTime = filesystem::last_write_time(source, error);
+        if (error || sourceTime > snapshotTime) return false;
+    }
+    return true;
+}
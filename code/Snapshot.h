@@ -0,0 +1,136 @@
+/**
+ * @file Snapshot.h
+ * @brief Header file containing the binary snapshot format of the parsed data.
+ *
+ * Parsing the CSV files and computing the distance of every flight route dominates the startup time, so the
+ * parsed graph and airline registry can be written once to a binary snapshot and mapped back on the next
+ * launches. The snapshot holds a string table, the airlines, the airports, the CSR adjacency (see FrozenGraph)
+ * with the precomputed distances and the airline ID list of every flight route, and the contraction hierarchy of
+ * the distances (see ContractionHierarchy) if it was built.
+ *
+ * Layout (native byte order, every section starts at a multiple of 8 bytes):
+ *   SnapshotHeader
+ *   SnapshotAirline[numAirlines]
+ *   SnapshotAirport[numAirports]
+ *   uint32_t offsets[numAirports + 1]
+ *   uint32_t targets[numEdges]
+ *   double distances[numEdges]
+ *   uint32_t airlineOffsets[numEdges + 1]
+ *   AirlineId airlineIds[numAirlineIds]
+ *   int32_t ranks[numRanks]
+ *   SnapshotArc arcs[numArcs]
+ *   char strings[stringBytes]
+ */
+
+#ifndef AED_AIRPORTS_SNAPSHOT_H
+#define AED_AIRPORTS_SNAPSHOT_H
+
+#include "ContractionHierarchy.h"
+#include "Graph.h"
+#include <cstdint>
+
+/**
+ * @brief Version of the snapshot format, snapshots with another version are ignored.
+ */
+const uint32_t SNAPSHOT_VERSION = 2;
+
+/**
+ * @struct SnapshotHeader
+ * @brief First bytes of a snapshot file.
+ */
+struct SnapshotHeader {
+    char magic[8];              ///< "AIRSNAP" followed by a null character.
+    uint32_t version;           ///< The format version (SNAPSHOT_VERSION).
+    uint32_t numAirlines;       ///< The number of airlines.
+    uint32_t numAirports;       ///< The number of airports.
+    uint32_t numEdges;          ///< The number of flight routes.
+    uint32_t numAirlineIds;     ///< The total number of airline IDs over all flight routes.
+    uint32_t numRanks;          ///< The number of ranks of the contraction hierarchy, 0 or the number of airports.
+    uint32_t numArcs;           ///< The number of arcs of the contraction hierarchy.
+    uint32_t stringBytes;       ///< The size of the string table.
+    uint64_t payloadBytes;      ///< The size of everything after the header.
+    uint64_t checksum;          ///< Checksum of everything after the header.
+};
+
+/**
+ * @struct SnapshotString
+ * @brief Reference to a string of the string table.
+ */
+struct SnapshotString {
+    uint32_t offset;    ///< Offset of the first character in the string table.
+    uint32_t length;    ///< The number of characters.
+};
+
+/**
+ * @struct SnapshotAirline
+ * @brief Airline record of a snapshot, stored in airline ID order.
+ */
+struct SnapshotAirline {
+    SnapshotString code;        ///< The ICAO code of the airline.
+    SnapshotString name;        ///< The official name of the airline.
+    SnapshotString callsign;    ///< The callsign of the airline.
+    SnapshotString country;     ///< The country of registry.
+};
+
+/**
+ * @struct SnapshotAirport
+ * @brief Airport record of a snapshot, stored in vertex ID order.
+ */
+struct SnapshotAirport {
+    SnapshotString code;        ///< The IATA code of the airport.
+    SnapshotString name;        ///< The airport name.
+    SnapshotString city;        ///< The city where the airport is located.
+    SnapshotString country;     ///< The country where the airport is located.
+    double latitude;            ///< Latitude of the airport.
+    double longitude;           ///< Longitude of the airport.
+    int32_t flightsFrom;        ///< The number of flights from the airport.
+    int32_t flightsTo;          ///< The number of flights to the airport.
+};
+
+/**
+ * @struct SnapshotArc
+ * @brief Arc record of the contraction hierarchy, a flight route or a shortcut.
+ */
+struct SnapshotArc {
+    int32_t source;     ///< The vertex ID of the first airport.
+    int32_t target;     ///< The vertex ID of the last airport.
+    int32_t middle;     ///< The vertex ID of the airport a shortcut replaces, -1 for a flight route.
+    int32_t flights;    ///< The number of flights the arc stands for.
+    double distance;    ///< The distance of the arc, in kilometers.
+};
+
+/**
+ * @brief Writes a snapshot of the parsed data.
+ * @param path Path of the snapshot file, it is written to a temporary file first and then renamed.
+ * @param graph The airport graph.
+ * @param registry The airline registry used by the flight routes of the graph.
+ * @param hierarchy The contraction hierarchy of the graph, empty if it was not built.
+ * @return True if the snapshot was written, otherwise false.
+ *
+ * Time Complexity: O(V+E*A+H) where A stands for the number of airlines of each edge and H for the arcs of the hierarchy.
+ */
+bool WriteSnapshot(const std::string& path, const Graph<Airport>& graph, const AirlineRegistry& registry,
+                   const ContractionHierarchy& hierarchy);
+
+/**
+ * @brief Loads a snapshot into an empty graph and airline registry.
+ * @param path Path of the snapshot file.
+ * @param graph [out] The empty graph where the airports and flight routes are added.
+ * @param registry [out] The empty registry where the airlines are added.
+ * @param hierarchy [out] Receives the contraction hierarchy, left empty if the snapshot has none.
+ * @return True if the snapshot was loaded, false if it is missing, of another version or corrupted, in which
+ * case the graph, the registry and the hierarchy are left untouched.
+ *
+ * Time Complexity: O(V+E*A+H), the file is mapped and no text is parsed.
+ */
+bool ReadSnapshot(const std::string& path, Graph<Airport>& graph, AirlineRegistry& registry, ContractionHierarchy& hierarchy);
+
+/**
+ * @brief Checks if a snapshot exists and is newer than the files it was built from.
+ * @param path Path of the snapshot file.
+ * @param sources Paths of the CSV files the snapshot was built from.
+ * @return True if the snapshot was modified after every source file, otherwise false.
+ */
+bool IsSnapshotFresh(const std::string& path, const std::vector<std::string>& sources);
+
+#endif //AED_AIRPORTS_SNAPSHOT_H
@@ -10,6 +10,14 @@ string TrimString(const string& toTrim) {
     return trimmed;
 }
 
+string_view TrimView(string_view toTrim) {
+    while (!toTrim.empty() && isspace(static_cast<unsigned char>(toTrim.front())))
+        toTrim.remove_prefix(1);
+    while (!toTrim.empty() && isspace(static_cast<unsigned char>(toTrim.back())))
+        toTrim.remove_suffix(1);
+    return toTrim;
+}
+
 double ToRadians(double degrees) {
     return degrees * M_PI / 180.0;
 }
@@ -3,7 +3,7 @@
  * @brief Contains utility functions for string manipulation and geographical calculations.
  *
  * This header file provides various utility functions used for string manipulation and geographical calculations.
- * Functions include string trimming, conversion to radians, Haversine distance calculation,
+ * Functions include string trimming (with and without copies), conversion to radians, Haversine distance calculation,
  * converting strings to lowercase, removing spaces, and formatting text in bold for terminal output.
  */
 
@@ -12,6 +12,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <cmath>
 #include <sstream>
@@ -24,6 +25,13 @@
  */
 std::string TrimString(const std::string& toTrim);
 
+/**
+ * @brief Trim whitespace from the beginning and end of a string view, without copying it.
+ * @param toTrim The view to be trimmed.
+ * @return The trimmed view, pointing into the same characters.
+ */
+std::string_view TrimView(std::string_view toTrim);
+
 /**
  * @brief Converts degrees to radians.
  * @param degrees The angle in degrees to be converted.
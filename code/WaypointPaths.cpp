@@ -0,0 +1,86 @@
+#include "WaypointPaths.h"
+#include <limits>
+
+WaypointPaths::WaypointPaths(const FrozenGraph& graph, const vector<int>& sources, const vector<int>& targets,
+                             const vector<int>& layovers, SearchContext& context) {
+    for (size_t i = 0; i <= layovers.size(); i++) {
+        legs.emplace_back(graph, i == 0 ? sources : vector<int>{layovers[i - 1]},
+                          i == layovers.size() ? targets : vector<int>{layovers[i]}, context);
+        if (legs.back().empty()) {
+            legs.clear();
+            flights = 0;
+            return;
+        }
+        flights += legs.back().getNumFlights();
+    }
+}
+
+uint64_t WaypointPaths::countPaths() const {
+    if (empty())
+        return 0;
+
+    uint64_t paths = 1;
+    for (const auto& leg : legs) {
+        uint64_t count = leg.countPaths();
+        paths = (paths > numeric_limits<uint64_t>::max() / count) ? numeric_limits<uint64_t>::max() : paths * count;
+    }
+    return paths;
+}
+
+WaypointPaths::Iterator::Iterator(const WaypointPaths* paths) : paths(paths) {
+    // The steps of the last leg come first, each leg from its arrival back to its source, so the flights are
+    // chosen from the last one to the first one and the junction of two legs is written by both
+    int position = paths->flights;
+    for (int leg = static_cast<int>(paths->legs.size()) - 1; leg >= 0; leg--) {
+        int legFlights = paths->legs[leg].getNumFlights();
+        for (int k = 0; k <= legFlights; k++) {
+            stepLegs.push_back(leg);
+            stepPositions.push_back(position - k);
+        }
+        position -= legFlights;
+    }
+    stepNodes.assign(stepLegs.size(), 0);
+    choices.assign(stepLegs.size(), 0);
+    path.resize(paths->flights + 1);
+    advance(0);
+}
+
+void WaypointPaths::Iterator::advance(int step) {
+    int steps = static_cast<int>(choices.size());
+    int k = step;
+    while (k >= 0) {
+        if (k == steps)
+            return;
+
+        // Out of predecessors: move the previous step to its next choice
+        const ShortestPathDag& dag = paths->legs[stepLegs[k]];
+        int node = stepNodes[k];
+        if (choices[k] >= dag.parentsEnd(node) - dag.parentsBegin(node)) {
+            if (--k >= 0)
+                choices[k]++;
+            continue;
+        }
+
+        int parent = dag.getParent(dag.parentsBegin(node) + choices[k]);
+        path[stepPositions[k]] = dag.getNode(parent);
+
+        if (k + 1 < steps) {
+            stepNodes[k + 1] = stepLegs[k + 1] == stepLegs[k] ? parent : 0;
+            choices[k + 1] = 0;
+        }
+        k++;
+    }
+
+    paths = nullptr;
+    stepLegs.clear();
+    stepPositions.clear();
+    stepNodes.clear();
+    choices.clear();
+    path.clear();
+}
+
+WaypointPaths::Iterator& WaypointPaths::Iterator::operator++() {
+    choices.back()++;
+    advance(static_cast<int>(choices.size()) - 1);
+    return *this;
+}
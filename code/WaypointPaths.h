@@ -0,0 +1,149 @@
+/**
+ * @file WaypointPaths.h
+ * @brief Header file containing the smallest paths through a sequence of custom layovers.
+ *
+ * The smallest paths through custom layovers used to be built as the Cartesian product of the smallest paths of
+ * each leg, copying every merged path, so a few hub layovers made the time and the memory explode. The legs are
+ * independent, so the 'WaypointPaths' class runs a single search per leg and keeps the predecessor DAG of each
+ * one: the paths are the product of the DAGs, counted without enumerating them and enumerated lazily, one path
+ * at a time.
+ */
+
+#ifndef AED_AIRPORTS_WAYPOINTPATHS_H
+#define AED_AIRPORTS_WAYPOINTPATHS_H
+
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+#include "ShortestPathDag.h"
+#include <cstdint>
+#include <iterator>
+
+/**
+ * @class WaypointPaths
+ * @brief Every path with the fewest flights from a set of source airports to a set of target airports, going
+ * through custom layovers in order, stored as one DAG per leg.
+ *
+ * The first leg goes from the sources to the first layover, each following one from a layover to the next, and
+ * the last one to the targets. Without layovers, there is a single leg.
+ */
+class WaypointPaths {
+private:
+    vector<ShortestPathDag> legs;       ///< The smallest paths of each leg.
+    int flights = 0;                    ///< The number of flights of each path, 0 if there is no path.
+
+public:
+    /**
+     * @class Iterator
+     * @brief Forward iterator over the paths, building each path only when it is reached.
+     *
+     * The iterator chains the steps of the DAGs back from the target of the last leg to the source of the first
+     * one, and advances like an odometer: the choice closest to the source moves first.
+     */
+    class Iterator {
+    private:
+        const WaypointPaths* paths = nullptr;       ///< The enumerated paths, nullptr for the end iterator.
+        vector<int> stepLegs;                       ///< The leg of each step.
+        vector<int> stepPositions;                  ///< The position in the path of the airport chosen at each step.
+        vector<int> stepNodes;                      ///< The node whose predecessor is chosen at each step.
+        vector<int> choices;                        ///< The predecessor chosen at each step, as an index in its range.
+        vector<Vertex<Airport>*> path;              ///< The current path, from the source to the target.
+
+        /**
+         * @brief Moves to the first path keeping the choices before a given step.
+         * @param step The first step that may change, starting from its current choice.
+         */
+        void advance(int step);
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = vector<Vertex<Airport>*>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        /**
+         * @brief Constructs the end iterator.
+         */
+        Iterator() = default;
+
+        /**
+         * @brief Constructs an iterator at the first path.
+         * @param paths The paths, with at least one path.
+         */
+        explicit Iterator(const WaypointPaths* paths);
+
+        reference operator*() const { return path; }
+        pointer operator->() const { return &path; }
+
+        /**
+         * @brief Advances to the next path, or to the end if it was the last one.
+         * @return Reference to this iterator.
+         *
+         * Time Complexity: O(L) amortized, where L stands for the number of flights of the paths.
+         */
+        Iterator& operator++();
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return paths == other.paths && choices == other.choices; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Constructs an empty set of paths.
+     */
+    WaypointPaths() = default;
+
+    /**
+     * @brief Searches the smallest paths of every leg.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the paths.
+     * @param sources The vertex IDs of the starting airports.
+     * @param targets The vertex IDs of the destination airports.
+     * @param layovers The vertex IDs of the airports the paths must go through, in order (may be empty).
+     * @param context The search context used by the search of each leg.
+     *
+     * Time Complexity: O((L+1)*(V+E)) where L stands for the layovers, V for vertices and E for edges.
+     */
+    WaypointPaths(const FrozenGraph& graph, const vector<int>& sources, const vector<int>& targets,
+                  const vector<int>& layovers, SearchContext& context);
+
+    /**
+     * @brief Checks if some path goes through every layover to a target.
+     * @return True if there is no path, otherwise false.
+     */
+    bool empty() const { return flights == 0; }
+
+    /**
+     * @brief Retrieves the number of flights of the smallest paths.
+     * @return The number of flights, 0 if there is no path.
+     */
+    int getNumFlights() const { return flights; }
+
+    /**
+     * @brief Counts the paths without enumerating them.
+     * @return The number of paths, the product of the counts of the legs, saturated at the maximum value of uint64_t.
+     *
+     * Time Complexity: O(N+P) where N stands for the nodes and P for the predecessor links of the DAGs.
+     */
+    uint64_t countPaths() const;
+
+    /**
+     * @brief Retrieves an iterator at the first path.
+     * @return The iterator, equal to end() if there is no path.
+     */
+    Iterator begin() const {
+        return empty() ? Iterator() : Iterator(this);
+    }
+
+    /**
+     * @brief Retrieves the end iterator.
+     * @return The iterator past the last path.
+     */
+    Iterator end() const { return Iterator(); }
+};
+
+#endif //AED_AIRPORTS_WAYPOINTPATHS_H
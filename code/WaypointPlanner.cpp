@@ -0,0 +1,193 @@
+#include "WaypointPlanner.h"
+#include <limits>
+
+static const double INFINITE_COST = numeric_limits<double>::infinity();
+
+// Adds two (primary, secondary) costs
+static pair<double, double> addCosts(const pair<double, double>& a, const pair<double, double>& b) {
+    return {a.first + b.first, a.second + b.second};
+}
+
+WaypointPlanner::WaypointPlanner(const FrozenGraph& graph) : graph(graph) {}
+
+pair<double, double> WaypointPlanner::edgeCost(int e, RouteObjective objective) const {
+    if (objective == RouteObjective::DISTANCE)
+        return {graph.getDistance(e), 1};
+    return {1, graph.getDistance(e)};
+}
+
+vector<pair<double, double>> WaypointPlanner::searchCosts(const vector<int>& seeds, const vector<vector<int>>& ends,
+                                                          RouteObjective objective, SearchContext& context) const {
+    context.begin(graph.getNumVertex());
+    auto& heap = context.heap();
+    for (int seed : seeds) {
+        if (context.isVisited(seed))
+            continue;
+        context.setVisited(seed);
+        context.setMark(seed, 1);
+        context.cost(seed) = {0, 0};
+        heap.push(context.cost(seed), seed);
+    }
+    while (!heap.empty()) {
+        int v = heap.top().second;
+        heap.pop();
+        if (context.isProcessing(v))
+            continue;
+        context.setProcessing(v, true);
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getTarget(e);
+            pair<double, double> cost = addCosts(context.cost(v), edgeCost(e, objective));
+            if (context.isVisited(w) && !(cost < context.cost(w)))
+                continue;
+            context.setVisited(w);
+            context.cost(w) = cost;
+            heap.push(cost, w);
+        }
+    }
+
+    // A seed is at cost 0, so it is reached through the best flight into it instead
+    vector<pair<double, double>> costs;
+    for (const auto& group : ends) {
+        pair<double, double> best = {INFINITE_COST, INFINITE_COST};
+        for (int v : group) {
+            if (!context.isMarked(v)) {
+                if (context.isVisited(v))
+                    best = min(best, context.cost(v));
+                continue;
+            }
+            for (int i = graph.inEdgesBegin(v); i < graph.inEdgesEnd(v); i++) {
+                if (context.isVisited(graph.getSource(i)))
+                    best = min(best, addCosts(context.cost(graph.getSource(i)), edgeCost(graph.getInEdge(i), objective)));
+            }
+        }
+        costs.push_back(best);
+    }
+    return costs;
+}
+
+WaypointPlan WaypointPlanner::plan(const vector<int>& sources, const vector<int>& targets, const vector<int>& waypoints,
+                                   RouteObjective objective, SearchContext& context) const {
+    WaypointPlan plan;
+    vector<int> positions;
+    for (size_t i = 0; i < waypoints.size(); i++) {
+        if (find(waypoints.begin(), waypoints.begin() + i, waypoints[i]) == waypoints.begin() + i)
+            positions.push_back(static_cast<int>(i));
+    }
+    int n = static_cast<int>(positions.size());
+
+    // Row 0 holds the costs from the sources and row i+1 the costs from layover i, column n the costs to the targets
+    vector<vector<int>> ends;
+    for (int position : positions)
+        ends.push_back({waypoints[position]});
+    ends.push_back(targets);
+    vector<vector<pair<double, double>>> costs;
+    costs.push_back(searchCosts(sources, ends, objective, context));
+    for (int position : positions)
+        costs.push_back(searchCosts({waypoints[position]}, ends, objective, context));
+
+    auto total = [&](const vector<int>& order) {
+        pair<double, double> cost = costs[0][order.empty() ? n : order[0]];
+        for (size_t i = 0; i + 1 < order.size(); i++)
+            cost = addCosts(cost, costs[order[i] + 1][order[i + 1]]);
+        return order.empty() ? cost : addCosts(cost, costs[order.back() + 1][n]);
+    };
+
+    vector<int> order;
+    if (n <= HELD_KARP_MAX_WAYPOINTS) {
+        // best[mask][j] is the cost of visiting the layovers of mask from the sources, ending at layover j
+        plan.exact = true;
+        vector<vector<pair<double, double>>> best(size_t(1) << n, vector<pair<double, double>>(n, {INFINITE_COST, INFINITE_COST}));
+        vector<vector<int>> previous(size_t(1) << n, vector<int>(n, -1));
+        for (int j = 0; j < n; j++)
+            best[size_t(1) << j][j] = costs[0][j];
+        for (size_t mask = 1; mask < best.size(); mask++) {
+            for (int j = 0; j < n; j++) {
+                if (!(mask >> j & 1) || best[mask][j].first == INFINITE_COST)
+                    continue;
+                for (int next = 0; next < n; next++) {
+                    if (mask >> next & 1)
+                        continue;
+                    pair<double, double> cost = addCosts(best[mask][j], costs[j + 1][next]);
+                    size_t extended = mask | size_t(1) << next;
+                    if (cost < best[extended][next]) {
+                        best[extended][next] = cost;
+                        previous[extended][next] = j;
+                    }
+                }
+            }
+        }
+        if (n > 0) {
+            size_t mask = best.size() - 1;
+            int last = 0;
+            for (int j = 1; j < n; j++) {
+                if (addCosts(best[mask][j], costs[j + 1][n]) < addCosts(best[mask][last], costs[last + 1][n]))
+                    last = j;
+            }
+            while (last != -1) {
+                order.push_back(last);
+                int before = previous[mask][last];
+                mask ^= size_t(1) << last;
+                last = before;
+            }
+            reverse(order.begin(), order.end());
+        }
+    } else {
+        // Nearest neighbour first, then reverse a stretch or move a layover while it lowers the cost
+        vector<bool> visited(n, false);
+        for (int step = 0, from = 0; step < n; step++) {
+            int closest = -1;
+            for (int j = 0; j < n; j++) {
+                if (!visited[j] && (closest == -1 || costs[from][j] < costs[from][closest]))
+                    closest = j;
+            }
+            visited[closest] = true;
+            order.push_back(closest);
+            from = closest + 1;
+        }
+
+        pair<double, double> current = total(order);
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (int i = 0; i < n; i++) {
+                for (int j = i + 1; j < n; j++) {
+                    reverse(order.begin() + i, order.begin() + j + 1);
+                    pair<double, double> cost = total(order);
+                    if (cost < current) {
+                        current = cost;
+                        improved = true;
+                    } else {
+                        reverse(order.begin() + i, order.begin() + j + 1);
+                    }
+                }
+            }
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    if (i == j)
+                        continue;
+                    vector<int> moved = order;
+                    int waypoint = moved[i];
+                    moved.erase(moved.begin() + i);
+                    moved.insert(moved.begin() + j, waypoint);
+                    pair<double, double> cost = total(moved);
+                    if (cost < current) {
+                        current = cost;
+                        order.swap(moved);
+                        improved = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // An order missing layovers comes from a subset that cannot be extended to all of them
+    pair<double, double> cost = total(order);
+    if (static_cast<int>(order.size()) < n || cost.first == INFINITE_COST)
+        return plan;
+    plan.reachable = true;
+    for (int j : order)
+        plan.order.push_back(positions[j]);
+    plan.flights = static_cast<int>(objective == RouteObjective::FLIGHTS ? cost.first : cost.second);
+    plan.distance = objective == RouteObjective::DISTANCE ? cost.first : cost.second;
+    return plan;
+}
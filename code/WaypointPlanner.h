@@ -0,0 +1,87 @@
+/**
+ * @file WaypointPlanner.h
+ * @brief Header file containing the search of the best order to visit a set of custom layovers.
+ *
+ * Custom layovers are otherwise visited in the order they were entered. The 'WaypointPlanner' class treats them as
+ * a set and finds the order with the fewest flights or the shortest distance. The cost of every leg is computed
+ * first, with one search from the sources and one from each layover, so choosing the order never touches the graph
+ * again. Up to HELD_KARP_MAX_WAYPOINTS layovers, the order is exact (Held-Karp dynamic programming over the subsets
+ * of layovers visited); beyond that, a nearest-neighbour order is improved by reversing and moving layovers until
+ * no move lowers its cost.
+ */
+
+#ifndef AED_AIRPORTS_WAYPOINTPLANNER_H
+#define AED_AIRPORTS_WAYPOINTPLANNER_H
+
+#include "AStarRouter.h"
+#include "FrozenGraph.h"
+#include "SearchContext.h"
+
+/**
+ * @struct WaypointPlan
+ * @brief The best order found to visit a set of custom layovers.
+ */
+struct WaypointPlan {
+    vector<int> order;      ///< The positions of the layovers in the given list, in visiting order. A layover given twice is visited once.
+    bool reachable = false; ///< True if some order reaches a target through every layover.
+    bool exact = false;     ///< True if the order is optimal, false if it comes from the heuristic.
+    int flights = 0;        ///< The number of flights of the trip, chaining the best route of each leg.
+    double distance = 0;    ///< The total distance of the trip in kilometers.
+};
+
+/**
+ * @class WaypointPlanner
+ * @brief Orders custom layovers to minimize the flights or the distance of a trip going through all of them.
+ */
+class WaypointPlanner {
+private:
+    const FrozenGraph& graph;       ///< The CSR snapshot of the airport graph.
+
+    /**
+     * @brief Retrieves the cost of a flight route.
+     * @param e The edge index of the flight route.
+     * @param objective The minimized cost.
+     * @return The (primary, secondary) cost of the flight route for the objective.
+     */
+    pair<double, double> edgeCost(int e, RouteObjective objective) const;
+
+    /**
+     * @brief Computes the cost of the best route from a set of airports to each of several sets of airports.
+     * @param seeds The vertex IDs of the starting airports.
+     * @param ends The vertex IDs of each set of destination airports. A starting airport is only reached again
+     * through a round trip, as in the route searches.
+     * @param objective The minimized cost.
+     * @param context The search context holding the costs and heap of Dijkstra's algorithm.
+     * @return The (primary, secondary) cost to each set, infinite if it cannot be reached.
+     *
+     * Time Complexity: O((V+E)*log(V)) where V stands for vertices and E for edges.
+     */
+    vector<pair<double, double>> searchCosts(const vector<int>& seeds, const vector<vector<int>>& ends,
+                                             RouteObjective objective, SearchContext& context) const;
+
+public:
+    static const int HELD_KARP_MAX_WAYPOINTS = 12;  ///< The largest number of layovers ordered exactly.
+
+    /**
+     * @brief Constructor for the WaypointPlanner class.
+     * @param graph The CSR snapshot of the airport graph, which must outlive the planner.
+     */
+    explicit WaypointPlanner(const FrozenGraph& graph);
+
+    /**
+     * @brief Searches the best order to visit a set of custom layovers between the sources and the targets.
+     * @param sources The vertex IDs of the starting airports.
+     * @param targets The vertex IDs of the destination airports.
+     * @param waypoints The vertex IDs of the airports to go through, in any order.
+     * @param objective The minimized cost.
+     * @param context The search context used by the searches of the leg costs.
+     * @return The best order found, with its flights and distance.
+     *
+     * Time Complexity: O(W*(V+E)*log(V)+W^2*2^W) with W <= HELD_KARP_MAX_WAYPOINTS, where W stands for the layovers,
+     * V for vertices and E for edges. Beyond that bound, O(W*(V+E)*log(V)+I*W^3) where I stands for the improving passes.
+     */
+    WaypointPlan plan(const vector<int>& sources, const vector<int>& targets, const vector<int>& waypoints,
+                      RouteObjective objective, SearchContext& context) const;
+};
+
+#endif //AED_AIRPORTS_WAYPOINTPLANNER_H
@@ -1,12 +1,32 @@
 #include <iostream>
 #include "code/Script.h"
+#include "code/BatchMode.h"
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    BatchOptions batchOptions;
+    if (!args.empty() && !BatchMode::parseArguments(args, batchOptions)) {
+        std::cerr << "Usage: ./run [--batch <file|-> [--output <file|->] [--format csv|jsonl] [--threads N]]" << std::endl;
+        return 1;
+    }
 
-int main() {
     std::string airportsCSV = "data/airports.csv";
     std::string airlinesCSV = "data/airlines.csv";
     std::string flightsCSV = "data/flights.csv";
-    ParseData parseData(airportsCSV, airlinesCSV, flightsCSV);
-    Script script(parseData.getDataGraph(), parseData.getAirlinesInfo());
+    std::string snapshotFile = "data/graph.snapshot";
+    ParseData parseData(airportsCSV, airlinesCSV, flightsCSV, snapshotFile);
+
+    if (!args.empty()) {
+        BatchMode batchMode(parseData.getDataGraph(), parseData.getAirlineRegistry(), batchOptions);
+        return batchMode.run();
+    }
+
+    // The contraction hierarchy takes seconds to build, so it is only built by the first shortest distance search
+    Script script(parseData.getDataGraph(), parseData.getAirlineRegistry(), [&parseData, &snapshotFile]() {
+        if (!parseData.buildContractionHierarchy(snapshotFile))
+            std::cerr << "Warning: Unable to store the contraction hierarchy in " << snapshotFile << std::endl;
+        return &parseData.getContractionHierarchy();
+    });
 
     script.run();
 